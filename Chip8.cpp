@@ -1,13 +1,9 @@
 #include <fstream>
 #include <iostream>
-#include <random>
 
 #include "Type.h"
 #include "Chip8.h"
-
-static std::random_device rd;
-static std::mt19937 gen(rd());
-std::uniform_int_distribution<u8> dist(0, 255);
+#include "Metrics.h"
 
 void Chip8::Reset() {
 	ProgramCounter = 0x200;
@@ -15,6 +11,10 @@ void Chip8::Reset() {
 	StackPointer = 0;
 	OperationCode = 0;
 	DelayTimer = 0;
+	Cycles = 0;
+	Frames = 0;
+	ProgramHash = 0;
+	WaitingForKey = false;
 
 	// Clear Display
 	std::fill(Display.begin(), Display.end(), false);
@@ -36,6 +36,21 @@ void Chip8::Reset() {
 	//Clear Key State
 	std::fill(KeyState.begin(), KeyState.end(), false);
 }
+void Chip8::Seed(u64 Seed) {
+	// SplitMix64 so Nearby Seeds Give Unrelated States, and the State is Never Zero
+	u64 Mixed = Seed + 0x9E3779B97F4A7C15;
+	Mixed = (Mixed ^ (Mixed >> 30)) * 0xBF58476D1CE4E5B9;
+	Mixed = (Mixed ^ (Mixed >> 27)) * 0x94D049BB133111EB;
+	Mixed ^= Mixed >> 31;
+	RandomState = Mixed != 0 ? Mixed : 0x9E3779B97F4A7C15;
+}
+u8 Chip8::NextRandom() {
+	// XorShift64*, the Whole Generator is RandomState so it Replays and Saves with the Machine
+	RandomState ^= RandomState >> 12;
+	RandomState ^= RandomState << 25;
+	RandomState ^= RandomState >> 27;
+	return static_cast<u8>((RandomState * 0x2545F4914F6CDD1D) >> 56);
+}
 bool Chip8::LoadProgram(const String &File) {
 	InputFileStream InputFile(File, std::ios::binary | std::ios::ate);
 	if (!InputFile.is_open()) {
@@ -46,6 +61,11 @@ bool Chip8::LoadProgram(const String &File) {
 	std::streamsize size = InputFile.tellg();
 	InputFile.seekg(0, std::ios::beg);
 
+	if (size <= 0) {
+		std::cerr << "ROM Empty: " << File << std::endl;
+		return false;
+	}
+
 	if (size > (4096 - 512)) {
 		std::cerr << "ROM Too Large! Size: " << size << " bytes." << std::endl;
 		InputFile.close();
@@ -60,6 +80,12 @@ bool Chip8::LoadProgram(const String &File) {
 
 	InputFile.close();
 
+	// FNV-1a of the ROM, Identifies the Program in Movies
+	ProgramHash = 0xCBF29CE484222325;
+	for (std::streamsize i = 0; i < size; ++i) {
+		ProgramHash = (ProgramHash ^ Memory[0x200 + i]) * 0x100000001B3;
+	}
+
 	// Debug: Print confirmation and size
 	std::cout << "ROM loaded successfully. Size: " << size << " bytes." << std::endl;
 
@@ -69,13 +95,14 @@ bool Chip8::LoadProgram(const String &File) {
 		u16 opcode = (Memory[0x200 + i] << 8) | Memory[0x200 + i + 1];
 		std::cout << "0x" << std::hex << opcode << " ";
 	}
-	std::cout << std::endl;
+	std::cout << std::dec << std::endl;
 
 	return true;
 }
 void Chip8::StackPush(u16 Data) {
 	if (StackPointer >= Stack.size()) {
 		std::cerr << "Stack Overflow!" << std::endl;
+		Metrics::Add(StackOverflows);
 		// Handle error
 		return;
 	}
@@ -85,6 +112,7 @@ void Chip8::StackPush(u16 Data) {
 u16 Chip8::StackPop() {
 	if (StackPointer == 0) {
 		std::cerr << "Stack Underflow!" << std::endl;
+		Metrics::Add(StackUnderflows);
 		// Handle error
 		return 0;
 	}
@@ -99,7 +127,9 @@ void Chip8::Tick() {
 
 	OperationCode = Memory[ProgramCounter] << 8 | Memory[ProgramCounter + 1];
 
+	u16 InstructionAddress = ProgramCounter;
 	bool Invalid = false;
+	Cycles++;
 
 	/*
 	 *The AND Operation done here says what the Instruction is supposed to be
@@ -287,7 +317,7 @@ void Chip8::Tick() {
 		}
 		//CXNN Set vX to rand & NN
 		case 0xC000: {
-			Register[(OperationCode & 0x0F00) >> 8] = (rand() % 256) & (OperationCode & 0x00FF);
+			Register[(OperationCode & 0x0F00) >> 8] = NextRandom() & (OperationCode & 0x00FF);
 			ProgramCounter += 2;
 			break;
 		}
@@ -296,6 +326,7 @@ void Chip8::Tick() {
 			u8 X = Register[(OperationCode & 0x0F00) >> 8];
 			u8 Y = Register[(OperationCode & 0x00F0) >> 4];
 			u8 height = OperationCode & 0x000F;
+			bool Changed = false;
 			Register[0xF] = 0;
 
 			for (int yline = 0; yline < height; yline++) {
@@ -304,6 +335,7 @@ void Chip8::Tick() {
 					break;
 				}
 				u8 pixel = Memory[IndexRegister + yline];
+				Changed |= pixel != 0;
 				for (int xline = 0; xline < 8; xline++) {
 					if ((pixel & (0x80 >> xline)) != 0) {
 						int xpos = (X + xline) % 64;
@@ -317,6 +349,9 @@ void Chip8::Tick() {
 					}
 				}
 			}
+			if (Latency && Changed) {
+				Latency->MarkDrawn();
+			}
 			Redraw = true;
 			ProgramCounter += 2;
 			break;
@@ -325,6 +360,9 @@ void Chip8::Tick() {
 			switch (OperationCode & 0x00FF) {
 				//EX9E Skip an Instruction if Key Stored in vX is True
 				case 0x009E: {
+					if (Latency) {
+						Latency->MarkObserved(Register[(OperationCode & 0x0F00) >> 8]);
+					}
 					if (KeyState[Register[(OperationCode & 0x0F00) >> 8]]) {
 						ProgramCounter += 4;
 					} else {
@@ -334,6 +372,9 @@ void Chip8::Tick() {
 				}
 				//EXA1 Skip an Instuction if Key Stored in vX is False
 				case 0x00A1: {
+					if (Latency) {
+						Latency->MarkObserved(Register[(OperationCode & 0x0F00) >> 8]);
+					}
 					if (!KeyState[Register[(OperationCode & 0x0F00) >> 8]]) {
 						ProgramCounter += 4;
 					} else {
@@ -364,12 +405,16 @@ void Chip8::Tick() {
 
 					for (i32 i = 0; i < 16; ++i) {
 						if (KeyState[i]) {
+							if (Latency) {
+								Latency->MarkObserved(i);
+							}
 							Register[(OperationCode & 0x0F00) >> 8] = i;
 							IsKeyPressed = true;
 							break;
 						}
 					}
 
+					WaitingForKey = !IsKeyPressed;
 					if (!IsKeyPressed) {
 						return;
 					}
@@ -452,11 +497,33 @@ void Chip8::Tick() {
 		}
 	}
 	if (Invalid) {
-		std::cerr << "Invalid Opcode: 0x" << std::hex << OperationCode << std::endl;
+		std::cerr << "Invalid Opcode: 0x" << std::hex << OperationCode << std::dec << std::endl;
+		Metrics::Add(InvalidOpcodes);
+	}
+
+	if (ExecutionTrace) {
+		ExecutionTrace->Record(Cycles, InstructionAddress, OperationCode, IndexRegister, Register);
 	}
 }
 void Chip8::TickTimer() {
+	Metrics::Add(TimerTicks);
 	if (DelayTimer > 0) {
 		DelayTimer--;
 	}
 }
+void Chip8::RunFrame(i32 TicksPerFrame) {
+	MetricTimer FrameTimer(FrameEmulationTime);
+
+	// Counted per Frame, Not per Instruction, to Keep Tick Free of Atomics
+	Metrics::Add(InstructionsExecuted, TicksPerFrame);
+	Metrics::Add(FramesEmulated);
+	Metrics::Set(TargetClockHz, static_cast<u64>(TicksPerFrame) * EMULATED_FRAME_RATE);
+
+	FrameTicks = TicksPerFrame;
+	for (FrameTick = 0; FrameTick < TicksPerFrame; ++FrameTick) {
+		Tick();
+	}
+	FrameTick = 0;
+	TickTimer();
+	Frames++;
+}
@@ -6,8 +6,36 @@
 #define CHIP8_H
 
 #include "Type.h"
+#include "ExecutionTrace.h"
+#include "Latency.h"
 
-class Chip8 {
+#define EMULATED_FRAME_RATE 60
+
+/*
+ * Everything that Makes Up a Running Machine, Kept Free of Pointers and Implicit Padding so Save States can
+ * Restore it with a Single Copy. Changing the Layout Requires Bumping SAVE_STATE_VERSION.
+ */
+struct Chip8State {
+	u64 Cycles;
+	u64 Frames;
+	u64 RandomState = 0x9E3779B97F4A7C15;
+	u64 ProgramHash = 0;
+	Array<u8, 4096> Memory;
+	Array<bool, 64 * 32> Display;
+	Array<u16, 16> Stack;
+	Array<u8, 16> Register;
+	Array<bool, 16> KeyState;
+	u16 ProgramCounter;
+	u16 IndexRegister;
+	u16 OperationCode;
+	u8 StackPointer;
+	u8 DelayTimer;
+	bool Redraw = false;
+	bool WaitingForKey = false;
+	u8 Reserved[6] = {};
+};
+
+class Chip8 : public Chip8State {
 	private:
 	    u8 Font[80] = {
 	        0xF0, 0x90, 0x90, 0x90, 0xF0, // 0
@@ -32,22 +60,21 @@ class Chip8 {
 		u16 StackPop();
 
 	public:
-		Array<bool, 64 * 32> Display;
-		bool Redraw = false;
-		Array<u8, 4096> Memory;
-		Array<bool, 16> KeyState;
-		Array<u8, 16> Register;
-		u16 ProgramCounter;
-		u16 IndexRegister;
-		u16 OperationCode;
-		Array<u16, 16> Stack;
-		u8 StackPointer;
-		u8 DelayTimer;
+		// Optional Instruction Trace and Input Latency Probe, Owned by the Caller
+		ExecutionTraceWriter *ExecutionTrace = nullptr;
+		LatencyTracker *Latency = nullptr;
+
+		// Position Within the Frame RunFrame is Running, Zero Between Frames
+		i32 FrameTick = 0;
+		i32 FrameTicks = 0;
 
 		void Reset();
+		void Seed(u64 Seed);
+		u8 NextRandom();
 		bool LoadProgram(const String &File);
 		void Tick();
 		void TickTimer();
+		void RunFrame(i32 TicksPerFrame);
 };
 
 #endif //CHIP8_H
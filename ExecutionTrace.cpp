@@ -0,0 +1,256 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include "ExecutionTrace.h"
+
+namespace {
+	constexpr char EXECUTION_TRACE_MAGIC[4] = {'O', '8', 'X', 'T'};
+	constexpr u16 EXECUTION_TRACE_VERSION = 1;
+
+	enum ExecutionRecordFlags : u8 {
+		CycleJump = 1 << 0,
+		PCJump = 1 << 1,
+		IndexChanged = 1 << 2,
+		RegistersChanged = 1 << 3,
+	};
+
+	u64 ZigZag(i64 Value) {
+		return (static_cast<u64>(Value) << 1) ^ static_cast<u64>(Value >> 63);
+	}
+	i64 UnZigZag(u64 Value) {
+		return static_cast<i64>(Value >> 1) ^ -static_cast<i64>(Value & 1);
+	}
+	void WriteVarint(std::vector<u8> &Output, u64 Value) {
+		while (Value >= 0x80) {
+			Output.push_back(static_cast<u8>(Value) | 0x80);
+			Value >>= 7;
+		}
+		Output.push_back(static_cast<u8>(Value));
+	}
+
+	void Encode(std::vector<u8> &Output, const ExecutionRecord &Record, const ExecutionRecord &Previous) {
+		u16 RegisterMask = 0;
+		for (i32 i = 0; i < 16; ++i) {
+			if (Record.Register[i] != Previous.Register[i]) {
+				RegisterMask |= 1 << i;
+			}
+		}
+
+		u8 Flags = 0;
+		if (Record.Cycle - Previous.Cycle != 1) {
+			Flags |= CycleJump;
+		}
+		if (Record.ProgramCounter != static_cast<u16>(Previous.ProgramCounter + 2)) {
+			Flags |= PCJump;
+		}
+		if (Record.IndexRegister != Previous.IndexRegister) {
+			Flags |= IndexChanged;
+		}
+		if (RegisterMask != 0) {
+			Flags |= RegistersChanged;
+		}
+
+		Output.push_back(Flags);
+		if (Flags & CycleJump) {
+			WriteVarint(Output, Record.Cycle - Previous.Cycle);
+		}
+		if (Flags & PCJump) {
+			WriteVarint(Output, ZigZag(static_cast<i64>(Record.ProgramCounter) - Previous.ProgramCounter));
+		}
+		Output.push_back(static_cast<u8>(Record.OperationCode >> 8));
+		Output.push_back(static_cast<u8>(Record.OperationCode));
+		if (Flags & IndexChanged) {
+			WriteVarint(Output, ZigZag(static_cast<i64>(Record.IndexRegister) - Previous.IndexRegister));
+		}
+		if (Flags & RegistersChanged) {
+			WriteVarint(Output, RegisterMask);
+			for (i32 i = 0; i < 16; ++i) {
+				if (RegisterMask & (1 << i)) {
+					Output.push_back(Record.Register[i]);
+				}
+			}
+		}
+	}
+}
+
+ExecutionTraceWriter::~ExecutionTraceWriter() {
+	Close();
+}
+bool ExecutionTraceWriter::Open(const String &File) {
+	Close();
+
+	OutputFile.open(File, std::ios::binary | std::ios::trunc);
+	if (!OutputFile.is_open()) {
+		std::cerr << "Failed to Open Execution Trace File: " << File << std::endl;
+		return false;
+	}
+
+	u8 Header[8];
+	std::memcpy(Header, EXECUTION_TRACE_MAGIC, 4);
+	Header[4] = static_cast<u8>(EXECUTION_TRACE_VERSION);
+	Header[5] = static_cast<u8>(EXECUTION_TRACE_VERSION >> 8);
+	Header[6] = 0;
+	Header[7] = 0;
+	OutputFile.write(reinterpret_cast<const char *>(Header), sizeof(Header));
+	BytesWritten = sizeof(Header);
+
+	Head.store(0, std::memory_order_relaxed);
+	Tail.store(0, std::memory_order_relaxed);
+	CachedTail = 0;
+	Running.store(true, std::memory_order_relaxed);
+	Worker = std::thread(&ExecutionTraceWriter::Stream, this);
+	return true;
+}
+void ExecutionTraceWriter::Close() {
+	if (!Worker.joinable()) {
+		return;
+	}
+
+	Running.store(false, std::memory_order_release);
+	Worker.join();
+	OutputFile.close();
+
+	std::cout << "Execution Trace Closed: " << RecordCount() << " records, " << BytesWritten << " bytes." << std::endl;
+}
+void ExecutionTraceWriter::Stream() {
+	std::vector<u8> Output;
+	Output.reserve(EXECUTION_TRACE_BUFFER_SIZE * 8);
+	ExecutionRecord Previous = {};
+
+	while (true) {
+		// Read Running Before Head so the Final Drain Sees Every Record Published Before Close
+		bool StillRunning = Running.load(std::memory_order_acquire);
+		u64 First = Tail.load(std::memory_order_relaxed);
+		u64 Last = Head.load(std::memory_order_acquire);
+
+		if (First == Last) {
+			if (!StillRunning) {
+				break;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+
+		Output.clear();
+		for (u64 i = First; i < Last; ++i) {
+			const ExecutionRecord &Record = Records[i % EXECUTION_TRACE_BUFFER_SIZE];
+			Encode(Output, Record, Previous);
+			Previous = Record;
+		}
+		Tail.store(Last, std::memory_order_release);
+
+		OutputFile.write(reinterpret_cast<const char *>(Output.data()), static_cast<std::streamsize>(Output.size()));
+		BytesWritten += Output.size();
+	}
+
+	OutputFile.flush();
+}
+
+bool ExecutionTraceReader::Open(const String &File) {
+	InputFile.close();
+	InputFile.clear();
+	InputFile.open(File, std::ios::binary);
+	if (!InputFile.is_open()) {
+		std::cerr << "Failed to Open Execution Trace File: " << File << std::endl;
+		return false;
+	}
+
+	u8 Header[8];
+	if (!InputFile.read(reinterpret_cast<char *>(Header), sizeof(Header)) || std::memcmp(Header, EXECUTION_TRACE_MAGIC, 4) != 0) {
+		std::cerr << "Not an Execution Trace: " << File << std::endl;
+		return false;
+	}
+
+	u16 Version = Header[4] | (Header[5] << 8);
+	if (Version != EXECUTION_TRACE_VERSION) {
+		std::cerr << "Unsupported Execution Trace Version " << Version << ": " << File << std::endl;
+		return false;
+	}
+
+	Buffer.clear();
+	Position = 0;
+	Previous = {};
+	return true;
+}
+bool ExecutionTraceReader::Fill(size_t Count) {
+	if (Buffer.size() - Position >= Count) {
+		return true;
+	}
+
+	Buffer.erase(Buffer.begin(), Buffer.begin() + static_cast<std::ptrdiff_t>(Position));
+	Position = 0;
+
+	size_t Size = Buffer.size();
+	Buffer.resize(Size + (1 << 20));
+	InputFile.read(reinterpret_cast<char *>(Buffer.data() + Size), 1 << 20);
+	Buffer.resize(Size + static_cast<size_t>(InputFile.gcount()));
+	return Buffer.size() >= Count;
+}
+bool ExecutionTraceReader::ReadByte(u8 &Byte) {
+	if (!Fill(1)) {
+		return false;
+	}
+	Byte = Buffer[Position++];
+	return true;
+}
+bool ExecutionTraceReader::ReadVarint(u64 &Value) {
+	Value = 0;
+	for (i32 Shift = 0; Shift < 64; Shift += 7) {
+		u8 Byte;
+		if (!ReadByte(Byte)) {
+			return false;
+		}
+		Value |= static_cast<u64>(Byte & 0x7F) << Shift;
+		if ((Byte & 0x80) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+bool ExecutionTraceReader::Next(ExecutionRecord &Record) {
+	u8 Flags;
+	if (!ReadByte(Flags)) {
+		return false;
+	}
+
+	Record = Previous;
+	u64 Value = 1;
+	if ((Flags & CycleJump) && !ReadVarint(Value)) {
+		return false;
+	}
+	Record.Cycle = Previous.Cycle + Value;
+
+	Value = ZigZag(2);
+	if ((Flags & PCJump) && !ReadVarint(Value)) {
+		return false;
+	}
+	Record.ProgramCounter = static_cast<u16>(Previous.ProgramCounter + UnZigZag(Value));
+
+	u8 High, Low;
+	if (!ReadByte(High) || !ReadByte(Low)) {
+		return false;
+	}
+	Record.OperationCode = static_cast<u16>(High << 8 | Low);
+
+	if (Flags & IndexChanged) {
+		if (!ReadVarint(Value)) {
+			return false;
+		}
+		Record.IndexRegister = static_cast<u16>(Previous.IndexRegister + UnZigZag(Value));
+	}
+
+	if (Flags & RegistersChanged) {
+		if (!ReadVarint(Value)) {
+			return false;
+		}
+		for (i32 i = 0; i < 16; ++i) {
+			if ((Value & (1 << i)) && !ReadByte(Record.Register[i])) {
+				return false;
+			}
+		}
+	}
+
+	Previous = Record;
+	return true;
+}
@@ -0,0 +1,105 @@
+#ifndef EXECUTIONTRACE_H
+#define EXECUTIONTRACE_H
+
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Type.h"
+
+#define EXECUTION_TRACE_BUFFER_SIZE (1 << 16)
+
+/*
+ * Trace File Layout
+ * Header: "O8XT", u16 Version (Little Endian), u16 Reserved
+ * Records, Each Encoded Against the Previous Record (which Starts Zeroed):
+ *   u8 Flags
+ *   Varint Cycle Delta            if Flags & CycleJump (otherwise the delta is 1)
+ *   Varint ZigZag PC Delta        if Flags & PCJump (otherwise PC advanced by 2)
+ *   u8 Opcode High, u8 Opcode Low
+ *   Varint ZigZag I Delta         if Flags & IndexChanged
+ *   Varint Register Mask, u8 vX   if Flags & RegistersChanged, one value per set bit in ascending order
+ * Registers and I Hold the State After the Instruction Executed, PC is the Address of the Instruction.
+ */
+struct ExecutionRecord {
+	u64 Cycle;
+	u16 ProgramCounter;
+	u16 OperationCode;
+	u16 IndexRegister;
+	Array<u8, 16> Register;
+};
+
+class ExecutionTraceWriter {
+	private:
+		std::unique_ptr<ExecutionRecord[]> Records = std::make_unique<ExecutionRecord[]>(EXECUTION_TRACE_BUFFER_SIZE);
+
+		// Head is Only Written by the Emulator, Tail Only by the Streaming Thread
+		alignas(64) std::atomic<u64> Head = 0;
+		u64 CachedTail = 0;
+		alignas(64) std::atomic<u64> Tail = 0;
+
+		std::atomic<bool> Running = false;
+		std::thread Worker;
+		std::ofstream OutputFile;
+		u64 BytesWritten = 0;
+
+		void Stream();
+
+	public:
+		ExecutionTraceWriter() = default;
+		~ExecutionTraceWriter();
+		ExecutionTraceWriter(const ExecutionTraceWriter &) = delete;
+		ExecutionTraceWriter &operator=(const ExecutionTraceWriter &) = delete;
+
+		bool Open(const String &File);
+		void Close();
+		bool IsOpen() const {
+			return Worker.joinable();
+		}
+		u64 RecordCount() const {
+			return Head.load(std::memory_order_relaxed);
+		}
+		u64 ByteCount() const {
+			return BytesWritten;
+		}
+
+		void Record(u64 Cycle, u16 ProgramCounter, u16 OperationCode, u16 IndexRegister, const Array<u8, 16> &Register) {
+			u64 Index = Head.load(std::memory_order_relaxed);
+
+			// Wait for the Streaming Thread Rather than Dropping Records, a Trace with Holes is Useless for Diffing
+			while (Index - CachedTail >= EXECUTION_TRACE_BUFFER_SIZE) {
+				CachedTail = Tail.load(std::memory_order_acquire);
+				if (Index - CachedTail >= EXECUTION_TRACE_BUFFER_SIZE) {
+					std::this_thread::yield();
+				}
+			}
+
+			ExecutionRecord &Slot = Records[Index % EXECUTION_TRACE_BUFFER_SIZE];
+			Slot.Cycle = Cycle;
+			Slot.ProgramCounter = ProgramCounter;
+			Slot.OperationCode = OperationCode;
+			Slot.IndexRegister = IndexRegister;
+			Slot.Register = Register;
+			Head.store(Index + 1, std::memory_order_release);
+		}
+};
+
+class ExecutionTraceReader {
+	private:
+		InputFileStream InputFile;
+		std::vector<u8> Buffer;
+		size_t Position = 0;
+		ExecutionRecord Previous = {};
+
+		bool Fill(size_t Count);
+		bool ReadByte(u8 &Byte);
+		bool ReadVarint(u64 &Value);
+
+	public:
+		bool Open(const String &File);
+		bool Next(ExecutionRecord &Record);
+};
+
+#endif //EXECUTIONTRACE_H
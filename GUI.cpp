@@ -1,63 +1,230 @@
 #include "GUI.h"
 
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 
-GUI::GUI(Chip8 *CoreInterpreter, GLuint DisplayTexture, GLubyte *DisplayPixels) {
+GUI::GUI(Chip8 *CoreInterpreter, const String &ProgramPath, GLuint DisplayTexture, GLubyte *DisplayPixels) {
     this->CoreInterpreter = CoreInterpreter;
+	this->ProgramPath = ProgramPath;
 	this->DisplayTexture = DisplayTexture;
 	this->DisplayPixels = DisplayPixels;
 	LastTimer = HighResolutionClock::now();
+	CoreInterpreter->Latency = &Latency;
+
+	String Directory = ProgramPath.empty() ? String(".") : std::filesystem::path(ProgramPath).parent_path().string();
+	std::strncpy(RomDirectory, Directory.empty() ? "." : Directory.c_str(), sizeof(RomDirectory) - 1);
+	RefreshRomFiles();
 }
-void GUI::Tick() {
-	if (ImGui::IsWindowFocused()) {
-		for (int i = 0; i < 16; ++i) {
-			CoreInterpreter->KeyState[i] = ImGui::IsKeyDown(static_cast<ImGuiKey>(KeyMap[i]));
-		}
+void GUI::SampleKeys() {
+	// Keys Only Reach the Machine while the Display has Focus, Typing into the Other Panels does Not Play
+	if (DisplayFocused) {
+		CoreInterpreter->KeyState = HostKeyState;
 	}
+}
+void GUI::Tick() {
+	SampleKeys();
 
 	NumberOfTicks++;
+	Metrics::Add(InstructionsExecuted);
 	CoreInterpreter->Tick();
 }
-void GUI::RenderDisplay(f32 FrameRate) {
-	ImGui::Begin("Display", NULL, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoTitleBar);
-	ImGui::SetWindowSize(ImVec2(32 + (64 * DISPLAY_SCALE), 32 + (32 * DISPLAY_SCALE)));
+void GUI::RunFrame() {
+	SampleKeys();
+
+	i32 TicksPerFrame = this->TicksPerFrame();
+	Recorder.RecordFrame(*CoreInterpreter, TicksPerFrame);
+
+	NumberOfTicks += TicksPerFrame;
+	CoreInterpreter->RunFrame(TicksPerFrame);
+}
+i32 GUI::TicksPerFrame() const {
+	// At Least One Tick, a Frame that Runs Nothing Cannot be Recorded or Replayed
+	return std::clamp(ClockSpeed / EMULATED_FRAME_RATE, 1, std::max(MAX_TICKS_PER_FRAME, 1));
+}
+bool GUI::IsEmulationIdle() const {
+	if (ProgramPath.empty() || Paused) {
+		return true;
+	}
+
+	// Blocked on FX0A with the Timer Stopped, Frames would Only Spin Until a Key Arrives. Movies Need Every Frame.
+	bool AnyKeyDown = std::find(CoreInterpreter->KeyState.begin(), CoreInterpreter->KeyState.end(), true) != CoreInterpreter->KeyState.end();
+	return CoreInterpreter->WaitingForKey && CoreInterpreter->DelayTimer == 0 && !AnyKeyDown && !Recorder.IsRecording();
+}
+void GUI::Update() {
+	TRACE_ZONE("Emulation");
+
+	SwapLoadedProgram();
 
 	if (SingleStepMode) {
 		SingleStepMode = false;
-		Tick();
+		if (!Recorder.IsRecording()) {
+			Tick();
+		}
 	}
 
-	i32 TicksPerFrame = std::min(static_cast<i32>(ClockSpeed / FrameRate), MAX_TICKS_PER_FRAME);
-	for (int i = 0; i < TicksPerFrame; ++i) {
-		Tick();
+	const auto FrameDuration = std::chrono::nanoseconds(1000000000 / EMULATED_FRAME_RATE);
+	auto CurrentTime = HighResolutionClock::now();
+	FrameAccumulator += std::chrono::duration_cast<std::chrono::nanoseconds>(CurrentTime - LastTimer);
+	LastTimer = CurrentTime;
+
+	SampleKeys();
+	if (IsEmulationIdle()) {
+		// Emulated Time Stands Still, but a Frame is Due the Moment the Machine Wakes Up
+		FrameAccumulator = FrameDuration;
+		return;
+	}
+
+	// Fixed Rate Emulated Frames, Each Runs the Same Ticks and One Timer Tick Regardless of the Host Refresh Rate
+	// After a Stall, Drop the Backlog Instead of Spiraling to Catch Up
+	i32 FramesRun = 0;
+	for (; FrameAccumulator >= FrameDuration; ++FramesRun) {
+		FrameAccumulator -= FrameDuration;
+		if (FramesRun < MAX_FRAMES_PER_UPDATE) {
+			RunFrame();
+		}
 	}
 
+	// Every Frame Past the First in One Update Ran Behind its Due Time
+	if (FramesRun > 1) {
+		Metrics::Add(FramesLate, std::min(FramesRun, MAX_FRAMES_PER_UPDATE) - 1);
+	}
+	if (FramesRun > MAX_FRAMES_PER_UPDATE) {
+		Metrics::Add(FramesDropped, FramesRun - MAX_FRAMES_PER_UPDATE);
+	}
+}
+bool GUI::NeedsFrame() {
 	auto CurrentTime = HighResolutionClock::now();
-	auto deltaTime = std::chrono::duration_cast<std::chrono::microseconds>(CurrentTime - LastTimer);
+	bool StatsDue = CurrentTime - LastUIFrame >= std::chrono::milliseconds(STATS_REFRESH_MS);
+
+	PreviousIterationRendered = !AdaptivePresentation || CoreInterpreter->Redraw || UIFramesPending > 0 || StatsDue;
+	if (PreviousIterationRendered) {
+		UIFramesPending = std::max(UIFramesPending - 1, 0);
+		LastUIFrame = CurrentTime;
+	}
+	return PreviousIterationRendered;
+}
+f64 GUI::WaitTimeout() const {
+	// Right After a Presented Frame VSync Paces the Loop, Waiting as Well would Only Add Latency
+	if (!AdaptivePresentation || PreviousIterationRendered) {
+		return 0;
+	}
+	if (Loader.IsBusy()) {
+		return LOADER_POLL_MS / 1000.0;
+	}
+
+	auto SinceUIFrame = std::chrono::duration<f64>(HighResolutionClock::now() - LastUIFrame).count();
+	f64 Timeout = STATS_REFRESH_MS / 1000.0 - SinceUIFrame;
+	if (!IsEmulationIdle()) {
+		Timeout = std::min(Timeout, 1.0 / EMULATED_FRAME_RATE - std::chrono::duration<f64>(FrameAccumulator).count());
+	}
+	return std::max(Timeout, 0.0);
+}
+void GUI::NotifyInput() {
+	// ImGui Needs a Few Frames to Settle Hover and Focus Changes after an Event
+	UIFramesPending = UI_SETTLE_FRAMES;
+}
+void GUI::StartRecording() {
+	// Movies Replay from Power On, so Recording Restarts the Program with a Fresh Seed
+	// Built on the Side, so a ROM that has Gone Missing Leaves the Running Session as it Was
+	u64 Seed = static_cast<u64>(std::chrono::system_clock::now().time_since_epoch().count());
+	Chip8 Fresh;
+	Fresh.Reset();
+	Fresh.Seed(Seed);
+	if (!Fresh.LoadProgram(ProgramPath)) {
+		return;
+	}
+
+	static_cast<Chip8State &>(*CoreInterpreter) = Fresh;
+	CoreInterpreter->Redraw = true;
+	NumberOfTicks = 0;
+	FrameAccumulator = std::chrono::nanoseconds::zero();
+	Recorder.Begin(*CoreInterpreter, Seed, TicksPerFrame());
+}
+void GUI::RequestProgram(const String &Path) {
+	Loader.Request(Path);
+}
+void GUI::OnKey(i32 Key, i32 Action) {
+	NotifyInput();
+	if (Action == GLFW_REPEAT) {
+		return;
+	}
+	for (u8 i = 0; i < 16; ++i) {
+		if (KeyMap[i] == static_cast<GLuint>(Key)) {
+			HostKeyState[i] = Action == GLFW_PRESS;
+			Latency.MarkInput(i);
+		}
+	}
+}
+void GUI::OnPresented() {
+	Latency.MarkPresented();
+}
+void GUI::SwapLoadedProgram() {
+	// Runs Between Frames, the Window, GL Resources and Settings All Stay as they Are
+	auto Loaded = Loader.TakeReady();
+	if (!Loaded) {
+		return;
+	}
+
+	// A Movie or Execution Trace Only Makes Sense for the Program it Started With
+	if (Recorder.IsRecording()) {
+		Recorder.End(*CoreInterpreter, MOVIE_FILE);
+	}
+	if (ExecutionTrace.IsOpen()) {
+		CoreInterpreter->ExecutionTrace = nullptr;
+		ExecutionTrace.Close();
+	}
 
-	if (deltaTime.count() >= 16666) { // Approximately every 16.67ms for 60Hz
-		CoreInterpreter->TickTimer();
-		LastTimer = CurrentTime;
+	static_cast<Chip8State &>(*CoreInterpreter) = Loaded->State;
+	ProgramPath = Loaded->Path;
+	NumberOfTicks = 0;
+	FrameAccumulator = std::chrono::nanoseconds::zero();
+}
+void GUI::RefreshRomFiles() {
+	RomFiles.clear();
+
+	std::error_code Error;
+	for (const auto &Entry : std::filesystem::directory_iterator(RomDirectory, Error)) {
+		String Extension = Entry.path().extension().string();
+		if (Entry.is_regular_file(Error) && (Extension == ".ch8" || Extension == ".CH8")) {
+			RomFiles.push_back(Entry.path().string());
+		}
 	}
+	std::sort(RomFiles.begin(), RomFiles.end());
+}
+void GUI::RenderDisplay() {
+	ImGui::Begin("Display", NULL, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoTitleBar);
+	ImGui::SetWindowSize(ImVec2(32 + (64 * DISPLAY_SCALE), 32 + (32 * DISPLAY_SCALE)));
+
+	DisplayFocused = ImGui::IsWindowFocused();
 
 	if (CoreInterpreter->Redraw) {
 		CoreInterpreter->Redraw = false;
+		MetricTimer UploadTimer(TextureUploadTime);
 
-		for (int i = 0; i < 64 * 32; ++i) {
-			if (CoreInterpreter->Display[i]) {
-				DisplayPixels[i * 3 + 0] = static_cast<GLubyte>(ForeGroundColor.x * 255);
-				DisplayPixels[i * 3 + 1] = static_cast<GLubyte>(ForeGroundColor.y * 255);
-				DisplayPixels[i * 3 + 2] = static_cast<GLubyte>(ForeGroundColor.z * 255);
-			} else {
-				DisplayPixels[i * 3 + 0] = static_cast<GLubyte>(BackGroundColor.x * 255);
-				DisplayPixels[i * 3 + 1] = static_cast<GLubyte>(BackGroundColor.y * 255);
-				DisplayPixels[i * 3 + 2] = static_cast<GLubyte>(BackGroundColor.z * 255);
+		{
+			TRACE_ZONE("Texture Conversion");
+			for (int i = 0; i < 64 * 32; ++i) {
+				if (CoreInterpreter->Display[i]) {
+					DisplayPixels[i * 3 + 0] = static_cast<GLubyte>(ForeGroundColor.x * 255);
+					DisplayPixels[i * 3 + 1] = static_cast<GLubyte>(ForeGroundColor.y * 255);
+					DisplayPixels[i * 3 + 2] = static_cast<GLubyte>(ForeGroundColor.z * 255);
+				} else {
+					DisplayPixels[i * 3 + 0] = static_cast<GLubyte>(BackGroundColor.x * 255);
+					DisplayPixels[i * 3 + 1] = static_cast<GLubyte>(BackGroundColor.y * 255);
+					DisplayPixels[i * 3 + 2] = static_cast<GLubyte>(BackGroundColor.z * 255);
+				}
 			}
 		}
 
-		glBindTexture(GL_TEXTURE_2D, DisplayTexture);
-		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 64, 32, GL_RGB, GL_UNSIGNED_BYTE, DisplayPixels);
-		glBindTexture(GL_TEXTURE_2D, 0);
+		{
+			TRACE_ZONE("Texture Upload");
+			glBindTexture(GL_TEXTURE_2D, DisplayTexture);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 64, 32, GL_RGB, GL_UNSIGNED_BYTE, DisplayPixels);
+			glBindTexture(GL_TEXTURE_2D, 0);
+			Latency.MarkUploaded();
+		}
 
 		GLenum Error = glGetError();
 		if (Error != GL_NO_ERROR) {
@@ -86,9 +253,29 @@ void GUI::RenderGeneral(f32 FrameRate) {
 	ImGui::SameLine();
 	ImGui::Text("%d", DISPLAY_SCALE);
 
+	ImGui::TextColored(LabelColor, "Frames: ");
+	ImGui::SameLine();
+	ImGui::Text("%llu", static_cast<unsigned long long>(CoreInterpreter->Frames));
+
+	ImGui::Checkbox("Paused", &Paused);
+	ImGui::SameLine();
+	// A Step Runs Outside an Emulated Frame, the Movie would Miss it
+	ImGui::BeginDisabled(Recorder.IsRecording());
+	if (ImGui::Button("Step")) {
+		SingleStepMode = true;
+	}
+	ImGui::EndDisabled();
+	ImGui::SameLine();
+	if (CoreInterpreter->WaitingForKey) {
+		ImGui::TextColored(LabelColor, "Waiting for Key");
+	}
+	ImGui::Checkbox("Adaptive Presentation", &AdaptivePresentation);
+
 	ImGui::TextColored(LabelColor, "Clock: ");
 	ImGui::SameLine();
-	ImGui::InputInt("Hz", &ClockSpeed);
+	if (ImGui::InputInt("Hz", &ClockSpeed)) {
+		ClockSpeed = std::max(ClockSpeed, EMULATED_FRAME_RATE);
+	}
 
 	// Color Editors
 	if (ImGui::ColorEdit3("ForeGround Color", reinterpret_cast<float *>(&ForeGroundColor))) {
@@ -106,11 +293,159 @@ void GUI::RenderGeneral(f32 FrameRate) {
 	ImGui::SliderInt("Max Ticks per Frame", &MaxTicks, 1, 50);
 	MAX_TICKS_PER_FRAME = MaxTicks;
 
+	if (!ExecutionTrace.IsOpen()) {
+		if (ImGui::Button("Start Execution Trace") && ExecutionTrace.Open(EXECUTION_TRACE_FILE)) {
+			CoreInterpreter->ExecutionTrace = &ExecutionTrace;
+		}
+	} else {
+		if (ImGui::Button("Stop Execution Trace")) {
+			CoreInterpreter->ExecutionTrace = nullptr;
+			ExecutionTrace.Close();
+		}
+		ImGui::SameLine();
+		ImGui::Text("%llu Records", static_cast<unsigned long long>(ExecutionTrace.RecordCount()));
+	}
+
+	if (!Recorder.IsRecording()) {
+		ImGui::BeginDisabled(ProgramPath.empty());
+		if (ImGui::Button("Record Movie")) {
+			StartRecording();
+		}
+		ImGui::EndDisabled();
+	} else {
+		if (ImGui::Button("Stop Recording")) {
+			Recorder.End(*CoreInterpreter, MOVIE_FILE);
+		}
+		ImGui::SameLine();
+		ImGui::TextColored(SuccessColor, "Recording " MOVIE_FILE);
+	}
+
+	ImGui::Separator();
+	ImGui::TextColored(LabelColor, "Input Latency (ms)");
+	ImGui::SameLine();
+	if (ImGui::Button("Reset Latency")) {
+		Latency.Reset();
+	}
+	for (i32 i = 0; i < LATENCY_STAGE_COUNT; ++i) {
+		const auto Stage = static_cast<LatencyStage>(i);
+		const auto &Histogram = Latency.GetHistogram(Stage);
+		ImGui::Text("%-22s p50 %7.2f  p95 %7.2f  p99 %7.2f  (%llu)", LatencyTracker::StageName(Stage),
+		            Histogram.Percentile(0.50) / 1e6, Histogram.Percentile(0.95) / 1e6, Histogram.Percentile(0.99) / 1e6,
+		            static_cast<unsigned long long>(Histogram.GetCount()));
+	}
+	ImGui::Separator();
+
+	if (ImGui::Button("Save State")) {
+		SaveState::Save(*CoreInterpreter, SAVE_STATE_FILE);
+	}
+	ImGui::SameLine();
+	// Restoring Mid Recording would Desync the Movie
+	ImGui::BeginDisabled(Recorder.IsRecording());
+	if (ImGui::Button("Load State")) {
+		SaveState::Load(*CoreInterpreter, SAVE_STATE_FILE);
+	}
+	ImGui::EndDisabled();
+	ImGui::SameLine();
+	if (ImGui::Button("Add to " SAVE_STATE_BANK_FILE)) {
+		SaveStateBank::Append(*CoreInterpreter, SAVE_STATE_BANK_FILE);
+	}
+
+	ImGui::End();
+}
+void GUI::RenderTrace() {
+	ImGui::Begin("Trace", NULL, ImGuiWindowFlags_AlwaysAutoResize);
+
+	bool TraceEnabled = Tracer::IsEnabled();
+	if (ImGui::Checkbox("Enabled", &TraceEnabled)) {
+		Tracer::SetEnabled(TraceEnabled);
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Clear")) {
+		Tracer::Clear();
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Dump " TRACE_FILE)) {
+		Tracer::DumpChromeJSON(TRACE_FILE);
+	}
+
+	// Flame View of the Last Complete Frame, Zones are Recorded when they End so Children Precede their Parent
+	TraceEvents.clear();
+	Tracer::CopyThreadEvents(TraceEvents, 256);
+
+	auto Frame = std::find_if(TraceEvents.rbegin(), TraceEvents.rend(), [](const TraceEvent &Event) {
+		return Event.Depth == 0 && std::strcmp(Event.Name, TRACE_FRAME_ZONE) == 0;
+	});
+	if (Frame == TraceEvents.rend()) {
+		ImGui::TextDisabled("No Frames Recorded");
+		ImGui::End();
+		return;
+	}
+
+	f64 FrameDuration = static_cast<f64>(Frame->End - Frame->Start);
+	ImGui::TextColored(LabelColor, "Frame: ");
+	ImGui::SameLine();
+	ImGui::Text("%.3f ms", FrameDuration / 1e6);
+
+	const f32 Width = 64 * 10;
+	const f32 RowHeight = ImGui::GetTextLineHeightWithSpacing();
+	ImVec2 Origin = ImGui::GetCursorScreenPos();
+	ImDrawList *DrawList = ImGui::GetWindowDrawList();
+	u32 MaxDepth = 0;
+
+	for (auto Event = Frame; Event != TraceEvents.rend() && Event->End >= Frame->Start; ++Event) {
+		MaxDepth = std::max(MaxDepth, Event->Depth);
+
+		ImVec2 Min(Origin.x + static_cast<f32>((Event->Start - Frame->Start) / FrameDuration) * Width, Origin.y + Event->Depth * RowHeight);
+		ImVec2 Max(Origin.x + static_cast<f32>((Event->End - Frame->Start) / FrameDuration) * Width, Min.y + RowHeight - 1);
+		Max.x = std::max(Max.x, Min.x + 1);
+
+		f32 Shade = 1.0f - 0.15f * Event->Depth;
+		DrawList->AddRectFilled(Min, Max, ImGui::GetColorU32(ImVec4(ForeGroundColor.x * Shade, ForeGroundColor.y * Shade, ForeGroundColor.z * Shade, 1.0f)));
+		DrawList->PushClipRect(Min, Max, true);
+		DrawList->AddText(ImVec2(Min.x + 2, Min.y), IM_COL32(255, 255, 255, 255), Event->Name);
+		DrawList->PopClipRect();
+
+		if (ImGui::IsMouseHoveringRect(Min, Max)) {
+			ImGui::SetTooltip("%s: %.3f ms", Event->Name, (Event->End - Event->Start) / 1e6);
+		}
+	}
+	ImGui::Dummy(ImVec2(Width, (MaxDepth + 1) * RowHeight));
+
+	ImGui::End();
+}
+void GUI::RenderBrowser() {
+	ImGui::Begin("ROMs");
+
+	if (ImGui::InputText("Directory", RomDirectory, sizeof(RomDirectory))) {
+		RefreshRomFiles();
+	}
+	if (ImGui::Button("Refresh")) {
+		RefreshRomFiles();
+	}
+	ImGui::SameLine();
+	if (Loader.IsBusy()) {
+		ImGui::TextColored(LabelColor, "Loading...");
+	} else if (Loader.HasFailed()) {
+		ImGui::TextColored(LabelColor, "Load Failed");
+	} else {
+		ImGui::TextDisabled("Drop a ROM on the Window or Pick One");
+	}
+
+	ImGui::Separator();
+	for (const auto &File : RomFiles) {
+		String Name = std::filesystem::path(File).filename().string();
+		if (ImGui::Selectable(Name.c_str(), File == ProgramPath)) {
+			RequestProgram(File);
+		}
+	}
+
 	ImGui::End();
 }
 void GUI::Render() {
 	auto FrameRate = ImGui::GetIO().Framerate;
 
-	RenderDisplay(FrameRate);
+	RenderDisplay();
 	RenderGeneral(FrameRate);
+	RenderTrace();
+	RenderBrowser();
 }
@@ -1,13 +1,31 @@
 #ifndef GUI_H
 #define GUI_H
 
+#include <vector>
+
 #include <GLFW/glfw3.h>
 #include <imgui.h>
 
 #include "Type.h"
 #include "Chip8.h"
+#include "Trace.h"
+#include "Movie.h"
+#include "SaveState.h"
+#include "RomLoader.h"
+#include "Latency.h"
+#include "Metrics.h"
 
 #define DISPLAY_SCALE 30
+#define MAX_FRAMES_PER_UPDATE 4
+#define UI_SETTLE_FRAMES 3
+#define STATS_REFRESH_MS 500
+#define LOADER_POLL_MS 5
+#define TRACE_FILE "OctoPlay.trace.json"
+#define TRACE_FRAME_ZONE "Frame"
+#define EXECUTION_TRACE_FILE "OctoPlay.o8x"
+#define MOVIE_FILE "OctoPlay.o8m"
+#define SAVE_STATE_FILE "OctoPlay.o8s"
+#define SAVE_STATE_BANK_FILE "OctoPlay.o8b"
 
 class GUI {
 	private:
@@ -30,29 +48,67 @@ class GUI {
 
 		i32 NumberOfTicks = 0;
 		bool SingleStepMode = false;
+		bool Paused = false;
+
+		// Skip UI Rebuilds and Swaps when Neither the Display nor the UI Changed
+		bool AdaptivePresentation = true;
+		bool PreviousIterationRendered = true;
+		i32 UIFramesPending = UI_SETTLE_FRAMES;
+		NanoTimePoint LastUIFrame;
+
+		Array<bool, 16> HostKeyState = {};
+		bool DisplayFocused = false;
 
 		i32 ClockSpeed = 500;
 		i32 PreviousClockSpeed = ClockSpeed;
 		Chip8 *CoreInterpreter;
+		String ProgramPath;
 
 		i32 MAX_TICKS_PER_FRAME = 20;
 
 		NanoTimePoint LastTimer;
+		std::chrono::nanoseconds FrameAccumulator = std::chrono::nanoseconds::zero();
 
 		GLuint DisplayTexture;
 		GLubyte *DisplayPixels;
 
+		std::vector<TraceEvent> TraceEvents;
+		ExecutionTraceWriter ExecutionTrace;
+		MovieRecorder Recorder;
+
+		LatencyTracker Latency;
+
+		RomLoader Loader;
+		char RomDirectory[512] = {};
+		std::vector<String> RomFiles;
+
 		void Tick(); //Avoid Overhead & Compile Time Evaluation given Constant Args
+		void SampleKeys();
+		void RunFrame();
+		i32 TicksPerFrame() const;
+		bool IsEmulationIdle() const;
+		void StartRecording();
+		void SwapLoadedProgram();
+		void RefreshRomFiles();
 
-		void RenderDisplay(f32 FrameRate);
+		void RenderDisplay();
 		void RenderGeneral(f32 FrameRate);
+		void RenderTrace();
+		void RenderBrowser();
 		//constexpr void RenderCPUState();
 		//constexpr void RenderDebug();
 		//constexpr void RenderKeyState();
 		//constexpr void RenderStack();
 	public:
-		GUI(Chip8 *CoreInterpreter, GLuint DisplayTexture, GLubyte *DisplayPixels);
+		GUI(Chip8 *CoreInterpreter, const String &ProgramPath, GLuint DisplayTexture, GLubyte *DisplayPixels);
+		void Update();
+		bool NeedsFrame();
+		f64 WaitTimeout() const;
 		void Render();
+		void NotifyInput();
+		void RequestProgram(const String &Path);
+		void OnKey(i32 Key, i32 Action);
+		void OnPresented();
 };
 
 #endif //GUI_H
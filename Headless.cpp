@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "Chip8.h"
+#include "Latency.h"
+#include "Metrics.h"
+#include "Movie.h"
+#include "Observation.h"
+#include "SaveState.h"
+#include "Type.h"
+
+#define STATE_BANK_RESTORES 100000
+
+/*
+ * Replays a Movie Without a Window, so Recorded Gameplay can be Used as a Reproducible Benchmark Workload.
+ * The Display at the End has to Match the Recording Bit for Bit, Otherwise the Run does Not Count.
+ * With a Save State Bank Instead, Every Entry is Verified and Restoring One is Timed.
+ */
+static void PrintUsage(const char *Program) {
+	std::cerr << "Usage: " << std::endl << Program << " --replay Movie.o8m ROM.ch8 [--repeat N] [--trace Trace.o8x] [--observe] [--metrics-file Metrics.prom]" << std::endl;
+	std::cerr << Program << " --state-bank Bank.o8b [--state-index N] [--rom ROM.ch8]" << std::endl;
+}
+
+// The Newest Frame of an Observation has to be the Display, ORed with the Previous Display when Pooling
+static bool CheckObservation(const ObservationPipeline &Pipeline, const u8 *Output, const Chip8State &CoreInterpreter,
+                             const Array<bool, 64 * 32> &PreviousDisplay) {
+	const ObservationConfig &Config = Pipeline.GetConfig();
+	const u8 *Newest = Output + (Config.StackSize - 1) * Pipeline.FrameSize();
+
+	for (i32 i = 0; i < 64 * 32; ++i) {
+		bool On = CoreInterpreter.Display[i] || (Config.MaxPool && PreviousDisplay[i]);
+		if (Config.Format == ObservationFormat::F32) {
+			if (reinterpret_cast<const f32 *>(Newest)[i] != (On ? Config.OnScale : 0.0f)) {
+				return false;
+			}
+		} else if (Newest[i] != (On ? Config.OnValue : 0)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static i32 RunStateBank(const char *BankPath, u64 Index, const char *ProgramPath) {
+	SaveStateBank Bank;
+	if (!Bank.Open(BankPath)) {
+		return EXIT_FAILURE;
+	}
+
+	// With a ROM Loaded, Restores are Checked Against its Hash
+	Chip8 CoreInterpreter;
+	CoreInterpreter.Reset();
+	if (ProgramPath != nullptr && !CoreInterpreter.LoadProgram(ProgramPath)) {
+		return EXIT_FAILURE;
+	}
+
+	for (u64 i = 0; i < Bank.Count(); ++i) {
+		Chip8 Scratch = CoreInterpreter;
+		if (!Bank.Restore(i, Scratch, true)) {
+			std::cerr << "State " << i << " Failed Verification" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	std::cout << Bank.Count() << " states verified" << std::endl;
+
+	if (!Bank.Restore(Index, CoreInterpreter, true)) {
+		return EXIT_FAILURE;
+	}
+	std::cout << "State " << Index << ": " << CoreInterpreter.Frames << " frames, " << CoreInterpreter.Cycles
+	          << " instructions, PC 0x" << std::hex << CoreInterpreter.ProgramCounter << std::dec << std::endl;
+
+	for (bool Verify : {true, false}) {
+		auto Start = std::chrono::steady_clock::now();
+		for (i32 i = 0; i < STATE_BANK_RESTORES; ++i) {
+			Bank.Restore(Index, CoreInterpreter, Verify);
+		}
+		f64 Seconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - Start).count();
+		std::cout << "Restore " << (Verify ? "Verified" : "Unverified") << ": " << Seconds / STATE_BANK_RESTORES * 1e6 << " us" << std::endl;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+i32 main(i32 args, char **argv) {
+	const char *MoviePath = nullptr;
+	const char *ProgramPath = nullptr;
+	const char *TracePath = nullptr;
+	i32 Repeat = 1;
+	bool Observe = false;
+	const char *MetricsPath = nullptr;
+	const char *StateBankPath = nullptr;
+	u64 StateIndex = 0;
+
+	for (i32 i = 1; i < args; ++i) {
+		if (std::strcmp(argv[i], "--replay") == 0 && i + 2 < args) {
+			MoviePath = argv[++i];
+			ProgramPath = argv[++i];
+		} else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < args) {
+			Repeat = std::max(1, std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < args) {
+			TracePath = argv[++i];
+		} else if (std::strcmp(argv[i], "--observe") == 0) {
+			Observe = true;
+		} else if (std::strcmp(argv[i], "--metrics-file") == 0 && i + 1 < args) {
+			MetricsPath = argv[++i];
+		} else if (std::strcmp(argv[i], "--state-bank") == 0 && i + 1 < args) {
+			StateBankPath = argv[++i];
+		} else if (std::strcmp(argv[i], "--state-index") == 0 && i + 1 < args) {
+			StateIndex = std::strtoull(argv[++i], nullptr, 10);
+		} else if (std::strcmp(argv[i], "--rom") == 0 && i + 1 < args) {
+			ProgramPath = argv[++i];
+		} else {
+			PrintUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (StateBankPath != nullptr) {
+		return RunStateBank(StateBankPath, StateIndex, ProgramPath);
+	}
+	if (MoviePath == nullptr) {
+		PrintUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	Movie Recording;
+	if (!Recording.Load(MoviePath)) {
+		return EXIT_FAILURE;
+	}
+
+	if (MetricsPath != nullptr && !Metrics::StartExport(MetricsPath)) {
+		return EXIT_FAILURE;
+	}
+
+	ExecutionTraceWriter ExecutionTrace;
+	if (TracePath != nullptr && !ExecutionTrace.Open(TracePath)) {
+		return EXIT_FAILURE;
+	}
+
+	bool Passed = true;
+	f64 BestSeconds = 0;
+	f64 TotalSeconds = 0;
+	u64 Cycles = 0;
+
+	for (i32 Run = 0; Run < Repeat; ++Run) {
+		Chip8 CoreInterpreter;
+		CoreInterpreter.Reset();
+		CoreInterpreter.Seed(Recording.Seed);
+		if (!CoreInterpreter.LoadProgram(ProgramPath)) {
+			return EXIT_FAILURE;
+		}
+		if (CoreInterpreter.ProgramHash != Recording.ProgramHash) {
+			std::cerr << "ROM Does Not Match the Movie: " << ProgramPath << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		// Only Trace the First Run, Repeats are Identical
+		if (Run == 0 && ExecutionTrace.IsOpen()) {
+			CoreInterpreter.ExecutionTrace = &ExecutionTrace;
+		}
+
+		// Latency is Measured in Emulated Time, on the First Run Only so it does Not Skew the Benchmark
+		LatencyTracker Latency;
+		if (Run == 0) {
+			Latency.UseEmulatedTime(&CoreInterpreter);
+			CoreInterpreter.Latency = &Latency;
+		}
+
+		// Observes Every Frame Through a Batch of Pipelines Covering Both Formats With and Without Pooling, so its
+		// Cost Shows Up in the Benchmark. The First Run Also Checks the Output Against the Display.
+		ObservationConfig PooledConfig;
+		ObservationConfig FloatConfig;
+		FloatConfig.Format = ObservationFormat::F32;
+		FloatConfig.MaxPool = false;
+		FloatConfig.StackSize = 2;
+		FloatConfig.OnScale = 0.5f;
+		ObservationConfig PooledFloatConfig = FloatConfig;
+		PooledFloatConfig.MaxPool = true;
+		PooledFloatConfig.StackSize = 1;
+
+		std::vector<ObservationPipeline> Observations = {ObservationPipeline(PooledConfig), ObservationPipeline(FloatConfig),
+		                                                 ObservationPipeline(PooledFloatConfig)};
+		std::vector<const Chip8State *> ObservedInstances(Observations.size(), &CoreInterpreter);
+		size_t ObservationBytes = 0;
+		for (auto &Observation : Observations) {
+			Observation.Reset(CoreInterpreter);
+			ObservationBytes += Observation.ObservationSize();
+		}
+		std::vector<u8> ObservationBuffer(ObservationBytes);
+		Array<bool, 64 * 32> PreviousDisplay = CoreInterpreter.Display;
+		u64 ObservationMismatches = 0;
+
+		MoviePlayer Player;
+		Player.Begin(Recording);
+
+		auto Start = std::chrono::steady_clock::now();
+		while (!Player.IsFinished(CoreInterpreter)) {
+			Array<bool, 16> PreviousKeyState = CoreInterpreter.KeyState;
+			i32 TicksPerFrame = Player.ApplyFrame(CoreInterpreter);
+			if (CoreInterpreter.Latency) {
+				for (u8 i = 0; i < 16; ++i) {
+					if (CoreInterpreter.KeyState[i] != PreviousKeyState[i]) {
+						Latency.MarkInput(i);
+					}
+				}
+			}
+			CoreInterpreter.RunFrame(TicksPerFrame);
+			if (Observe) {
+				ObservationPipeline::StepBatch(Observations.data(), ObservedInstances.data(), Observations.size(),
+				                               ObservationBuffer.data(), nullptr, nullptr);
+				if (Run == 0) {
+					const u8 *Output = ObservationBuffer.data();
+					for (const auto &Observation : Observations) {
+						ObservationMismatches += !CheckObservation(Observation, Output, CoreInterpreter, PreviousDisplay);
+						Output += Observation.ObservationSize();
+					}
+					PreviousDisplay = CoreInterpreter.Display;
+				}
+			}
+		}
+		f64 Seconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - Start).count();
+
+		CoreInterpreter.ExecutionTrace = nullptr;
+		CoreInterpreter.Latency = nullptr;
+		ExecutionTrace.Close();
+		Latency.Print(std::cout);
+
+		if (ObservationMismatches > 0) {
+			std::cerr << "Observation Mismatches the Display in " << ObservationMismatches << " Frames" << std::endl;
+		}
+		bool Verified = Player.Verify(CoreInterpreter) && ObservationMismatches == 0;
+		Passed = Passed && Verified;
+		BestSeconds = Run == 0 ? Seconds : std::min(BestSeconds, Seconds);
+		TotalSeconds += Seconds;
+		Cycles = CoreInterpreter.Cycles;
+
+		std::cout << "Run " << Run + 1 << ": " << CoreInterpreter.Frames << " frames, " << Cycles << " instructions, "
+		          << Seconds * 1000 << " ms, " << (Verified ? "framebuffer matches" : "FRAMEBUFFER MISMATCH") << std::endl;
+	}
+
+	std::cout << "Best: " << BestSeconds * 1000 << " ms (" << Cycles / BestSeconds / 1e6 << " M instructions/s, "
+	          << Recording.FrameCount / BestSeconds << " frames/s)" << std::endl;
+	std::cout << "Mean: " << TotalSeconds / Repeat * 1000 << " ms" << std::endl;
+	std::cout << (Passed ? "PASS" : "FAIL") << std::endl;
+
+	// Stopping Writes a Final Snapshot, so Short Runs Still Leave Complete Counts Behind
+	Metrics::StopExport();
+
+	return Passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
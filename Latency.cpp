@@ -0,0 +1,128 @@
+#include <bit>
+
+#include "Latency.h"
+#include "Chip8.h"
+#include "ThreadRegistry.h"
+
+u32 LatencyHistogram::BucketIndex(u64 Value) {
+	if (Value < 8) {
+		return static_cast<u32>(Value);
+	}
+	u32 Exponent = 63 - std::countl_zero(Value);
+	return (Exponent - 2) * 8 + static_cast<u32>((Value >> (Exponent - 3)) & 7);
+}
+u64 LatencyHistogram::BucketValue(u32 Index) {
+	if (Index < 8) {
+		return Index;
+	}
+	u32 Exponent = Index / 8 + 2;
+	return (8 + static_cast<u64>(Index % 8)) << (Exponent - 3);
+}
+void LatencyHistogram::Add(u64 Value) {
+	Buckets[BucketIndex(Value)]++;
+	Count++;
+}
+void LatencyHistogram::Reset() {
+	Buckets.fill(0);
+	Count = 0;
+}
+u64 LatencyHistogram::Percentile(f64 Fraction) const {
+	if (Count == 0) {
+		return 0;
+	}
+
+	u64 Target = static_cast<u64>(Fraction * static_cast<f64>(Count - 1)) + 1;
+	u64 Seen = 0;
+	for (u32 i = 0; i < Buckets.size(); ++i) {
+		Seen += Buckets[i];
+		if (Seen >= Target) {
+			return BucketValue(i);
+		}
+	}
+	return BucketValue(static_cast<u32>(Buckets.size() - 1));
+}
+
+const char *LatencyTracker::StageName(LatencyStage Stage) {
+	switch (Stage) {
+		case InputToObserved:
+			return "Input -> Observed";
+		case ObservedToDrawn:
+			return "Observed -> Drawn";
+		case DrawnToUploaded:
+			return "Drawn -> Uploaded";
+		case UploadedToPresented:
+			return "Uploaded -> Presented";
+		case InputToPresented:
+			return "Input -> Presented";
+		default:
+			return "Unknown";
+	}
+}
+void LatencyTracker::UseEmulatedTime(const Chip8 *CoreInterpreter) {
+	EmulatedClock = CoreInterpreter;
+}
+u64 LatencyTracker::Now() const {
+	if (EmulatedClock != nullptr) {
+		// Ticks Spread Evenly Over their Frame, Whatever the Speed of that Frame
+		constexpr u64 FrameDuration = 1000000000 / EMULATED_FRAME_RATE;
+		u64 Time = EmulatedClock->Frames * FrameDuration;
+		if (EmulatedClock->FrameTicks > 0) {
+			Time += static_cast<u64>(EmulatedClock->FrameTick) * FrameDuration / EmulatedClock->FrameTicks;
+		}
+		return Time;
+	}
+	return Clock::Now();
+}
+void LatencyTracker::Advance(LatencyStage Stage, Step Next) {
+	u64 Time = Now();
+	Histograms[Stage].Add(Time - StageTime);
+	StageTime = Time;
+	Current = Next;
+
+	if (Next == Idle) {
+		Histograms[InputToPresented].Add(Time - InputTime);
+	}
+}
+void LatencyTracker::MarkInput(u8 Key) {
+	Current = WaitingObserved;
+	PendingKey = Key;
+	InputTime = Now();
+	StageTime = InputTime;
+}
+void LatencyTracker::MarkObserved(u8 Key) {
+	if (Current == WaitingObserved && Key == PendingKey) {
+		Advance(InputToObserved, WaitingDrawn);
+	}
+}
+void LatencyTracker::MarkDrawn() {
+	if (Current == WaitingDrawn) {
+		Advance(ObservedToDrawn, WaitingUploaded);
+	}
+}
+void LatencyTracker::MarkUploaded() {
+	if (Current == WaitingUploaded) {
+		Advance(DrawnToUploaded, WaitingPresented);
+	}
+}
+void LatencyTracker::MarkPresented() {
+	if (Current == WaitingPresented) {
+		Advance(UploadedToPresented, Idle);
+	}
+}
+void LatencyTracker::Reset() {
+	Current = Idle;
+	for (auto &Histogram : Histograms) {
+		Histogram.Reset();
+	}
+}
+void LatencyTracker::Print(std::ostream &Output) const {
+	for (i32 i = 0; i < LATENCY_STAGE_COUNT; ++i) {
+		const auto &Histogram = Histograms[i];
+		if (Histogram.GetCount() == 0) {
+			continue;
+		}
+		Output << "Latency " << StageName(static_cast<LatencyStage>(i)) << ": n=" << Histogram.GetCount()
+		       << " p50=" << Histogram.Percentile(0.50) / 1000 << "us p95=" << Histogram.Percentile(0.95) / 1000
+		       << "us p99=" << Histogram.Percentile(0.99) / 1000 << "us" << std::endl;
+	}
+}
@@ -0,0 +1,83 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <ostream>
+
+#include "Type.h"
+
+class Chip8;
+
+// Log-Linear Buckets, 8 per Power of Two, so Percentiles are Within 12.5% at Any Scale
+class LatencyHistogram {
+	private:
+		Array<u64, 496> Buckets = {};
+		u64 Count = 0;
+
+		static u32 BucketIndex(u64 Value);
+		static u64 BucketValue(u32 Index);
+
+	public:
+		void Add(u64 Value);
+		void Reset();
+		u64 GetCount() const {
+			return Count;
+		}
+		u64 Percentile(f64 Fraction) const;
+};
+
+enum LatencyStage {
+	InputToObserved,
+	ObservedToDrawn,
+	DrawnToUploaded,
+	UploadedToPresented,
+	InputToPresented,
+	LATENCY_STAGE_COUNT
+};
+
+/*
+ * Follows One Key Event at a Time Through the Pipeline: the GLFW Event, the First Instruction that Reads the Key
+ * (EX9E, EXA1, FX0A), the First DXYN that Changes Pixels After that, the Texture Upload and the Buffer Swap.
+ * A New Key Event Restarts the Measurement. Times are in Nanoseconds, of the Host Clock or, Without a Window,
+ * of Emulated Time Derived from the Frame Count and the Tick Within the Frame, which Follows Speed Changes.
+ */
+class LatencyTracker {
+	private:
+		enum Step {
+			Idle,
+			WaitingObserved,
+			WaitingDrawn,
+			WaitingUploaded,
+			WaitingPresented,
+		};
+
+		Step Current = Idle;
+		u8 PendingKey = 0;
+		u64 InputTime = 0;
+		u64 StageTime = 0;
+
+		const Chip8 *EmulatedClock = nullptr;
+
+		Array<LatencyHistogram, LATENCY_STAGE_COUNT> Histograms;
+
+		u64 Now() const;
+		void Advance(LatencyStage Stage, Step Next);
+
+	public:
+		static const char *StageName(LatencyStage Stage);
+
+		void UseEmulatedTime(const Chip8 *CoreInterpreter);
+
+		void MarkInput(u8 Key);
+		void MarkObserved(u8 Key);
+		void MarkDrawn();
+		void MarkUploaded();
+		void MarkPresented();
+
+		const LatencyHistogram &GetHistogram(LatencyStage Stage) const {
+			return Histograms[Stage];
+		}
+		void Reset();
+		void Print(std::ostream &Output) const;
+};
+
+#endif //LATENCY_H
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "Metrics.h"
+
+namespace {
+	struct CounterInfo {
+		const char *Name;
+		const char *Help;
+	};
+
+	constexpr CounterInfo COUNTER_INFO[METRIC_COUNTER_COUNT] = {
+		{"octoplay_instructions_total", "Instructions executed."},
+		{"octoplay_timer_ticks_total", "Delay timer ticks."},
+		{"octoplay_frames_total", "Emulated frames run."},
+		{"octoplay_frames_dropped_total", "Emulated frames skipped to catch up after a stall."},
+		{"octoplay_frames_late_total", "Emulated frames run after their due time, in a catch-up batch."},
+		{"octoplay_invalid_opcodes_total", "Invalid opcodes encountered."},
+		{"octoplay_stack_overflows_total", "Calls made with a full stack."},
+		{"octoplay_stack_underflows_total", "Returns made with an empty stack."},
+	};
+
+	constexpr CounterInfo TIMING_INFO[METRIC_TIMING_COUNT] = {
+		{"octoplay_texture_upload_seconds", "Time to convert and upload the display texture."},
+		{"octoplay_frame_emulation_seconds", "Time to run one emulated frame."},
+	};
+
+	std::mutex ExportMutex;
+	std::condition_variable ExportSignal;
+	bool ExportStopping = false;
+	String ExportFile;
+	u32 ExportInterval = METRICS_EXPORT_INTERVAL_MS;
+
+	// Stops the Exporter when main Returns Early, a Thread Still Joinable at Exit would Terminate the Process
+	struct ExportThread {
+		std::thread Worker;
+
+		~ExportThread() {
+			Metrics::StopExport();
+		}
+	} ExportWorker;
+}
+
+u32 Metrics::BucketIndex(u64 Nanoseconds) {
+	// Bucket i Holds Timings up to 2^i Microseconds
+	u64 Microseconds = (Nanoseconds + 999) / 1000;
+	u32 Index = Microseconds <= 1 ? 0 : static_cast<u32>(std::bit_width(Microseconds - 1));
+	return std::min<u32>(Index, METRIC_BUCKET_COUNT);
+}
+u64 Metrics::GetCounter(MetricCounter Counter) {
+	u64 Total = 0;
+	ThreadRegistry<MetricShard>::ForEach([&](const MetricShard &Shard) {
+		Total += Shard.Counters[Counter].load(std::memory_order_relaxed);
+	});
+	return Total;
+}
+void Metrics::WritePrometheus(std::ostream &Output, f64 AchievedClockHz) {
+	for (i32 i = 0; i < METRIC_COUNTER_COUNT; ++i) {
+		u64 Total = GetCounter(static_cast<MetricCounter>(i));
+		Output << "# HELP " << COUNTER_INFO[i].Name << " " << COUNTER_INFO[i].Help << "\n";
+		Output << "# TYPE " << COUNTER_INFO[i].Name << " counter\n";
+		Output << COUNTER_INFO[i].Name << " " << Total << "\n";
+	}
+
+	Output << "# HELP octoplay_clock_target_hz Instructions per second the emulator is set to run.\n";
+	Output << "# TYPE octoplay_clock_target_hz gauge\n";
+	Output << "octoplay_clock_target_hz " << Gauges[TargetClockHz].load(std::memory_order_relaxed) << "\n";
+	Output << "# HELP octoplay_clock_achieved_hz Instructions per second over the last export interval.\n";
+	Output << "# TYPE octoplay_clock_achieved_hz gauge\n";
+	Output << "octoplay_clock_achieved_hz " << AchievedClockHz << "\n";
+
+	for (i32 i = 0; i < METRIC_TIMING_COUNT; ++i) {
+		Array<u64, METRIC_BUCKET_COUNT + 1> Buckets = {};
+		u64 Sum = 0;
+		ThreadRegistry<MetricShard>::ForEach([&](const MetricShard &Shard) {
+			for (u32 j = 0; j <= METRIC_BUCKET_COUNT; ++j) {
+				Buckets[j] += Shard.Buckets[i][j].load(std::memory_order_relaxed);
+			}
+			Sum += Shard.TimingSums[i].load(std::memory_order_relaxed);
+		});
+
+		Output << "# HELP " << TIMING_INFO[i].Name << " " << TIMING_INFO[i].Help << "\n";
+		Output << "# TYPE " << TIMING_INFO[i].Name << " histogram\n";
+
+		// Count from the Buckets Rather than a Separate Counter, so the Two Always Agree
+		u64 Cumulative = 0;
+		for (u32 j = 0; j < METRIC_BUCKET_COUNT; ++j) {
+			Cumulative += Buckets[j];
+			Output << TIMING_INFO[i].Name << "_bucket{le=\"" << static_cast<f64>(1ull << j) / 1e6 << "\"} " << Cumulative << "\n";
+		}
+		Cumulative += Buckets[METRIC_BUCKET_COUNT];
+		Output << TIMING_INFO[i].Name << "_bucket{le=\"+Inf\"} " << Cumulative << "\n";
+		Output << TIMING_INFO[i].Name << "_sum " << static_cast<f64>(Sum) / 1e9 << "\n";
+		Output << TIMING_INFO[i].Name << "_count " << Cumulative << "\n";
+	}
+}
+void Metrics::Export() {
+	u64 PreviousTime = Clock::Now();
+	u64 PreviousInstructions = GetCounter(InstructionsExecuted);
+	std::unique_lock Lock(ExportMutex);
+
+	for (bool Stopping = false; !Stopping;) {
+		Stopping = ExportSignal.wait_for(Lock, std::chrono::milliseconds(ExportInterval), [] { return ExportStopping; });
+
+		u64 Time = Clock::Now();
+		u64 Instructions = GetCounter(InstructionsExecuted);
+		f64 AchievedClockHz = Time > PreviousTime ? (Instructions - PreviousInstructions) * 1e9 / (Time - PreviousTime) : 0;
+		PreviousTime = Time;
+		PreviousInstructions = Instructions;
+
+		// Write Beside the Target and Rename Over it, Scrapers See Either the Old or the New File
+		String TemporaryFile = ExportFile + ".tmp";
+		{
+			std::ofstream OutputFile(TemporaryFile, std::ios::trunc);
+			if (!OutputFile.is_open()) {
+				std::cerr << "Failed to Open Metrics File: " << TemporaryFile << std::endl;
+				continue;
+			}
+			WritePrometheus(OutputFile, AchievedClockHz);
+			if (!OutputFile.good()) {
+				std::cerr << "Failed to Write Metrics File: " << TemporaryFile << std::endl;
+				continue;
+			}
+		}
+
+		std::error_code Error;
+		std::filesystem::rename(TemporaryFile, ExportFile, Error);
+		if (Error) {
+			std::cerr << "Failed to Replace Metrics File: " << ExportFile << " (" << Error.message() << ")" << std::endl;
+		}
+	}
+}
+bool Metrics::StartExport(const String &File, u32 IntervalMilliseconds) {
+	StopExport();
+
+	std::ofstream Probe(File + ".tmp", std::ios::trunc);
+	if (!Probe.is_open()) {
+		std::cerr << "Failed to Open Metrics File: " << File << ".tmp" << std::endl;
+		return false;
+	}
+	Probe.close();
+
+	{
+		std::lock_guard Lock(ExportMutex);
+		ExportFile = File;
+		ExportInterval = std::max<u32>(IntervalMilliseconds, 1);
+		ExportStopping = false;
+	}
+	Enabled.store(true, std::memory_order_relaxed);
+	ExportWorker.Worker = std::thread(Export);
+	return true;
+}
+void Metrics::StopExport() {
+	if (!ExportWorker.Worker.joinable()) {
+		return;
+	}
+
+	{
+		std::lock_guard Lock(ExportMutex);
+		ExportStopping = true;
+	}
+	ExportSignal.notify_one();
+	ExportWorker.Worker.join();
+	Enabled.store(false, std::memory_order_relaxed);
+}
@@ -0,0 +1,102 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <ostream>
+
+#include "Type.h"
+#include "ThreadRegistry.h"
+
+#define METRICS_EXPORT_INTERVAL_MS 1000
+#define METRIC_BUCKET_COUNT 16
+
+enum MetricCounter {
+	InstructionsExecuted,
+	TimerTicks,
+	FramesEmulated,
+	FramesDropped,
+	FramesLate,
+	InvalidOpcodes,
+	StackOverflows,
+	StackUnderflows,
+	METRIC_COUNTER_COUNT
+};
+
+enum MetricGauge {
+	TargetClockHz,
+	METRIC_GAUGE_COUNT
+};
+
+enum MetricTiming {
+	TextureUploadTime,
+	FrameEmulationTime,
+	METRIC_TIMING_COUNT
+};
+
+/*
+ * Each Thread Counts into its Own Cache Line Aligned Shard, so an Update is a Relaxed Add Nobody Else Writes to.
+ * Timings Go into Power of Two Buckets from 1us, the Last Bucket Holds Everything Slower.
+ */
+struct alignas(64) MetricShard {
+	Array<std::atomic<u64>, METRIC_COUNTER_COUNT> Counters = {};
+	Array<Array<std::atomic<u64>, METRIC_BUCKET_COUNT + 1>, METRIC_TIMING_COUNT> Buckets = {};
+	Array<std::atomic<u64>, METRIC_TIMING_COUNT> TimingSums = {};
+};
+
+class Metrics {
+	private:
+		inline static std::atomic<bool> Enabled = false;
+		inline static Array<std::atomic<u64>, METRIC_GAUGE_COUNT> Gauges = {};
+
+		static u32 BucketIndex(u64 Nanoseconds);
+		static void Export();
+
+	public:
+		// Counters Always Count, Enabled Only Gates Timings that would Cost Clock Reads
+		static bool IsEnabled() {
+			return Enabled.load(std::memory_order_relaxed);
+		}
+
+		static void Add(MetricCounter Counter, u64 Value = 1) {
+			ThreadRegistry<MetricShard>::Local().Counters[Counter].fetch_add(Value, std::memory_order_relaxed);
+		}
+		static void Set(MetricGauge Gauge, u64 Value) {
+			Gauges[Gauge].store(Value, std::memory_order_relaxed);
+		}
+		static void Observe(MetricTiming Timing, u64 Nanoseconds) {
+			MetricShard &Shard = ThreadRegistry<MetricShard>::Local();
+			Shard.Buckets[Timing][BucketIndex(Nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+			Shard.TimingSums[Timing].fetch_add(Nanoseconds, std::memory_order_relaxed);
+		}
+
+		static u64 GetCounter(MetricCounter Counter);
+		static void WritePrometheus(std::ostream &Output, f64 AchievedClockHz);
+
+		// Rewrites File Every Interval from a Background Thread, Replacing it Whole so Scrapers Never See Half a File
+		static bool StartExport(const String &File, u32 IntervalMilliseconds = METRICS_EXPORT_INTERVAL_MS);
+		static void StopExport();
+};
+
+class MetricTimer {
+	private:
+		MetricTiming Timing;
+		u64 Start = 0;
+		bool Active;
+
+	public:
+		explicit MetricTimer(MetricTiming Timing) : Timing(Timing), Active(Metrics::IsEnabled()) {
+			if (Active) {
+				Start = Clock::Now();
+			}
+		}
+		~MetricTimer() {
+			if (Active) {
+				Metrics::Observe(Timing, Clock::Now() - Start);
+			}
+		}
+
+		MetricTimer(const MetricTimer &) = delete;
+		MetricTimer &operator=(const MetricTimer &) = delete;
+};
+
+#endif //METRICS_H
@@ -0,0 +1,202 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+#include "Movie.h"
+
+namespace {
+	constexpr char MOVIE_MAGIC[4] = {'O', '8', 'M', 'V'};
+	constexpr u16 MOVIE_VERSION = 1;
+
+	static_assert(std::is_trivially_copyable_v<MovieHeader> && std::is_trivially_copyable_v<MovieEvent>);
+
+	// Stored as u16, Anything Else would be Truncated and Replay at a Different Speed
+	bool IsValidTicksPerFrame(i32 TicksPerFrame) {
+		if (TicksPerFrame < 1 || TicksPerFrame > MOVIE_MAX_TICKS_PER_FRAME) {
+			std::cerr << "Ticks per Frame Out of Range for a Movie: " << TicksPerFrame << std::endl;
+			return false;
+		}
+		return true;
+	}
+}
+
+bool Movie::Save(const String &File) const {
+	std::ofstream OutputFile(File, std::ios::binary | std::ios::trunc);
+	if (!OutputFile.is_open()) {
+		std::cerr << "Failed to Open Movie File: " << File << std::endl;
+		return false;
+	}
+
+	MovieHeader Header = {};
+	std::memcpy(Header.Magic, MOVIE_MAGIC, 4);
+	Header.Version = MOVIE_VERSION;
+	Header.TicksPerFrame = static_cast<u16>(TicksPerFrame);
+	Header.QuirkFlags = QuirkFlags;
+	Header.EventCount = static_cast<u32>(Events.size());
+	Header.Seed = Seed;
+	Header.ProgramHash = ProgramHash;
+	Header.FrameCount = FrameCount;
+	Header.FinalCycles = FinalCycles;
+
+	OutputFile.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+	OutputFile.write(reinterpret_cast<const char *>(Events.data()), static_cast<std::streamsize>(Events.size() * sizeof(MovieEvent)));
+	OutputFile.write(reinterpret_cast<const char *>(FinalDisplay.data()), FinalDisplay.size());
+
+	if (!OutputFile.good()) {
+		std::cerr << "Failed to Write Movie File: " << File << std::endl;
+		return false;
+	}
+	return true;
+}
+bool Movie::Load(const String &File) {
+	InputFileStream InputFile(File, std::ios::binary);
+	if (!InputFile.is_open()) {
+		std::cerr << "Failed to Open Movie File: " << File << std::endl;
+		return false;
+	}
+
+	MovieHeader Header;
+	if (!InputFile.read(reinterpret_cast<char *>(&Header), sizeof(Header)) || std::memcmp(Header.Magic, MOVIE_MAGIC, 4) != 0) {
+		std::cerr << "Not a Movie File: " << File << std::endl;
+		return false;
+	}
+	if (Header.Version != MOVIE_VERSION) {
+		std::cerr << "Unsupported Movie Version " << Header.Version << ": " << File << std::endl;
+		return false;
+	}
+	if (Header.TicksPerFrame == 0) {
+		std::cerr << "Invalid Ticks per Frame in Movie File: " << File << std::endl;
+		return false;
+	}
+
+	// Bound the Count by the Bytes Left Before Allocating, a Corrupt Header Must Not Size the Vector
+	InputFile.seekg(0, std::ios::end);
+	u64 FileSize = static_cast<u64>(InputFile.tellg());
+	InputFile.seekg(sizeof(MovieHeader), std::ios::beg);
+	u64 EventBytes = FileSize >= sizeof(MovieHeader) + FinalDisplay.size() ? FileSize - sizeof(MovieHeader) - FinalDisplay.size() : 0;
+	if (Header.EventCount > EventBytes / sizeof(MovieEvent)) {
+		std::cerr << "Truncated Movie File: " << File << std::endl;
+		return false;
+	}
+
+	Events.resize(Header.EventCount);
+	InputFile.read(reinterpret_cast<char *>(Events.data()), static_cast<std::streamsize>(Events.size() * sizeof(MovieEvent)));
+	InputFile.read(reinterpret_cast<char *>(FinalDisplay.data()), FinalDisplay.size());
+	if (!InputFile) {
+		std::cerr << "Truncated Movie File: " << File << std::endl;
+		return false;
+	}
+	for (const auto &Event : Events) {
+		if (Event.Type == MovieEventType::TicksPerFrame && Event.Value == 0) {
+			std::cerr << "Invalid Ticks per Frame in Movie File: " << File << std::endl;
+			return false;
+		}
+	}
+
+	Seed = Header.Seed;
+	ProgramHash = Header.ProgramHash;
+	QuirkFlags = Header.QuirkFlags;
+	TicksPerFrame = Header.TicksPerFrame;
+	FrameCount = Header.FrameCount;
+	FinalCycles = Header.FinalCycles;
+	return true;
+}
+void Movie::PackDisplay(const Chip8 &CoreInterpreter, Array<u8, 256> &Packed) {
+	Packed.fill(0);
+	for (i32 i = 0; i < 64 * 32; ++i) {
+		if (CoreInterpreter.Display[i]) {
+			Packed[i / 8] |= 0x80 >> (i % 8);
+		}
+	}
+}
+
+bool MovieRecorder::Begin(const Chip8 &CoreInterpreter, u64 Seed, i32 TicksPerFrame) {
+	if (!IsValidTicksPerFrame(TicksPerFrame)) {
+		return false;
+	}
+
+	Recording = Movie();
+	Recording.Seed = Seed;
+	Recording.ProgramHash = CoreInterpreter.ProgramHash;
+	Recording.TicksPerFrame = TicksPerFrame;
+	PreviousKeyState.fill(false);
+	PreviousTicksPerFrame = TicksPerFrame;
+	Active = true;
+	return true;
+}
+bool MovieRecorder::RecordFrame(const Chip8 &CoreInterpreter, i32 TicksPerFrame) {
+	if (!Active) {
+		return false;
+	}
+	if (!IsValidTicksPerFrame(TicksPerFrame)) {
+		std::cerr << "Movie Recording Abandoned" << std::endl;
+		Active = false;
+		return false;
+	}
+
+	for (u8 i = 0; i < 16; ++i) {
+		if (CoreInterpreter.KeyState[i] != PreviousKeyState[i]) {
+			MovieEventType Type = CoreInterpreter.KeyState[i] ? MovieEventType::KeyDown : MovieEventType::KeyUp;
+			Recording.Events.push_back({CoreInterpreter.Frames, Type, i, 0, 0});
+			PreviousKeyState[i] = CoreInterpreter.KeyState[i];
+		}
+	}
+
+	if (TicksPerFrame != PreviousTicksPerFrame) {
+		Recording.Events.push_back({CoreInterpreter.Frames, MovieEventType::TicksPerFrame, 0, static_cast<u16>(TicksPerFrame), 0});
+		PreviousTicksPerFrame = TicksPerFrame;
+	}
+	return true;
+}
+bool MovieRecorder::End(const Chip8 &CoreInterpreter, const String &File) {
+	if (!Active) {
+		return false;
+	}
+	Active = false;
+
+	Recording.FrameCount = CoreInterpreter.Frames;
+	Recording.FinalCycles = CoreInterpreter.Cycles;
+	Movie::PackDisplay(CoreInterpreter, Recording.FinalDisplay);
+
+	if (!Recording.Save(File)) {
+		return false;
+	}
+	std::cout << "Movie Written: " << File << " (" << Recording.FrameCount << " frames, " << Recording.Events.size() << " events)" << std::endl;
+	return true;
+}
+
+void MoviePlayer::Begin(const Movie &Playing) {
+	this->Playing = &Playing;
+	NextEvent = 0;
+	TicksPerFrame = Playing.TicksPerFrame;
+}
+bool MoviePlayer::IsFinished(const Chip8 &CoreInterpreter) const {
+	return Playing == nullptr || CoreInterpreter.Frames >= Playing->FrameCount;
+}
+i32 MoviePlayer::ApplyFrame(Chip8 &CoreInterpreter) {
+	const auto &Events = Playing->Events;
+	while (NextEvent < Events.size() && Events[NextEvent].Frame <= CoreInterpreter.Frames) {
+		const MovieEvent &Event = Events[NextEvent++];
+		switch (Event.Type) {
+			case MovieEventType::KeyDown: {
+				CoreInterpreter.KeyState[Event.Key & 0xF] = true;
+				break;
+			}
+			case MovieEventType::KeyUp: {
+				CoreInterpreter.KeyState[Event.Key & 0xF] = false;
+				break;
+			}
+			case MovieEventType::TicksPerFrame: {
+				TicksPerFrame = Event.Value;
+				break;
+			}
+		}
+	}
+	return TicksPerFrame;
+}
+bool MoviePlayer::Verify(const Chip8 &CoreInterpreter) const {
+	Array<u8, 256> Packed;
+	Movie::PackDisplay(CoreInterpreter, Packed);
+	return Packed == Playing->FinalDisplay && CoreInterpreter.Cycles == Playing->FinalCycles;
+}
@@ -0,0 +1,94 @@
+#ifndef MOVIE_H
+#define MOVIE_H
+
+#include <vector>
+
+#include "Type.h"
+#include "Chip8.h"
+
+#define MOVIE_MAX_TICKS_PER_FRAME 0xFFFF
+
+/*
+ * Input Movie, Replays a Session Bit Exactly from Power On.
+ * Everything that Feeds the Emulation is Stored: the RNG Seed, the ROM Hash, the Quirk Settings (No Quirks are
+ * Implemented Yet, the Field is Reserved) and Every Key or Speed Change Keyed by Emulated Frame.
+ * The Display at the End of the Recording is Kept to Check a Replay Against.
+ */
+enum class MovieEventType : u8 {
+	KeyDown,
+	KeyUp,
+	TicksPerFrame,
+};
+
+struct MovieEvent {
+	u64 Frame;
+	MovieEventType Type;
+	u8 Key;
+	u16 Value;
+	u32 Reserved;
+};
+
+struct MovieHeader {
+	char Magic[4];
+	u16 Version;
+	u16 TicksPerFrame;
+	u32 QuirkFlags;
+	u32 EventCount;
+	u64 Seed;
+	u64 ProgramHash;
+	u64 FrameCount;
+	u64 FinalCycles;
+};
+
+class Movie {
+	public:
+		u64 Seed = 0;
+		u64 ProgramHash = 0;
+		u32 QuirkFlags = 0;
+		i32 TicksPerFrame = 0;
+		u64 FrameCount = 0;
+		u64 FinalCycles = 0;
+		std::vector<MovieEvent> Events;
+		Array<u8, 256> FinalDisplay = {};
+
+		bool Save(const String &File) const;
+		bool Load(const String &File);
+
+		static void PackDisplay(const Chip8 &CoreInterpreter, Array<u8, 256> &Packed);
+};
+
+class MovieRecorder {
+	private:
+		Movie Recording;
+		Array<bool, 16> PreviousKeyState = {};
+		i32 PreviousTicksPerFrame = 0;
+		bool Active = false;
+
+	public:
+		bool IsRecording() const {
+			return Active;
+		}
+
+		// The Machine Must be Freshly Reset, Seeded with Seed and Loaded
+		bool Begin(const Chip8 &CoreInterpreter, u64 Seed, i32 TicksPerFrame);
+		// Call with the Key State Set, Right Before Chip8::RunFrame. Ticks Outside 1 to MOVIE_MAX_TICKS_PER_FRAME End the Recording
+		bool RecordFrame(const Chip8 &CoreInterpreter, i32 TicksPerFrame);
+		bool End(const Chip8 &CoreInterpreter, const String &File);
+};
+
+class MoviePlayer {
+	private:
+		const Movie *Playing = nullptr;
+		size_t NextEvent = 0;
+		i32 TicksPerFrame = 0;
+
+	public:
+		// The Machine Must be Freshly Reset, Seeded with the Movie Seed and Loaded
+		void Begin(const Movie &Playing);
+		bool IsFinished(const Chip8 &CoreInterpreter) const;
+		// Applies the Inputs of the Next Frame and Returns how Many Ticks to Run It For
+		i32 ApplyFrame(Chip8 &CoreInterpreter);
+		bool Verify(const Chip8 &CoreInterpreter) const;
+};
+
+#endif //MOVIE_H
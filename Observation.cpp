@@ -0,0 +1,158 @@
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OBSERVATION_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "Observation.h"
+
+namespace {
+	// Bit x of a Row is the Pixel in Column x
+	u64 PackRow(const bool *Pixels) {
+#ifdef OBSERVATION_SSE2
+		u64 Row = 0;
+		for (i32 i = 0; i < 4; ++i) {
+			// Bools are 0 or 1, Moving the Low Bit to the Top of Each Byte Lets MoveMask Gather Them
+			__m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Pixels + i * 16));
+			Row |= static_cast<u64>(static_cast<u32>(_mm_movemask_epi8(_mm_slli_epi16(Bytes, 7)))) << (i * 16);
+		}
+		return Row;
+#else
+		u64 Row = 0;
+		for (i32 x = 0; x < 64; ++x) {
+			Row |= static_cast<u64>(Pixels[x]) << x;
+		}
+		return Row;
+#endif
+	}
+
+	void UnpackRow(u64 Row, u8 *Output, u8 OnValue) {
+#ifdef OBSERVATION_SSE2
+		const __m128i Select = _mm_set_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+		const __m128i On = _mm_set1_epi8(static_cast<char>(OnValue));
+		for (i32 i = 0; i < 4; ++i) {
+			u64 Low = (Row >> (i * 16)) & 0xFF;
+			u64 High = (Row >> (i * 16 + 8)) & 0xFF;
+			__m128i Bytes = _mm_set_epi64x(static_cast<i64>(High * 0x0101010101010101), static_cast<i64>(Low * 0x0101010101010101));
+			__m128i Mask = _mm_cmpeq_epi8(_mm_and_si128(Bytes, Select), Select);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(Output + i * 16), _mm_and_si128(Mask, On));
+		}
+#else
+		for (i32 x = 0; x < 64; ++x) {
+			Output[x] = (Row >> x) & 1 ? OnValue : 0;
+		}
+#endif
+	}
+
+	void UnpackRow(u64 Row, f32 *Output, f32 OnScale) {
+#ifdef OBSERVATION_SSE2
+		const __m128i Select = _mm_set_epi32(8, 4, 2, 1);
+		const __m128 On = _mm_set1_ps(OnScale);
+		for (i32 i = 0; i < 16; ++i) {
+			__m128i Nibble = _mm_set1_epi32(static_cast<i32>((Row >> (i * 4)) & 0xF));
+			__m128i Mask = _mm_cmpeq_epi32(_mm_and_si128(Nibble, Select), Select);
+			_mm_storeu_ps(Output + i * 4, _mm_and_ps(_mm_castsi128_ps(Mask), On));
+		}
+#else
+		for (i32 x = 0; x < 64; ++x) {
+			Output[x] = (Row >> x) & 1 ? OnScale : 0.0f;
+		}
+#endif
+	}
+}
+
+ObservationPipeline::ObservationPipeline(const ObservationConfig &Config) : Config(Config) {
+	this->Config.StackSize = std::max(this->Config.StackSize, 1);
+	Stack.resize(this->Config.StackSize);
+	Scores.resize(this->Config.Rewards.size());
+}
+size_t ObservationPipeline::FrameSize() const {
+	return 64 * 32 * (Config.Format == ObservationFormat::F32 ? sizeof(f32) : sizeof(u8));
+}
+size_t ObservationPipeline::ObservationSize() const {
+	return FrameSize() * Config.StackSize;
+}
+void ObservationPipeline::Pack(const Chip8State &CoreInterpreter, PackedFrame &Frame) {
+	for (i32 y = 0; y < 32; ++y) {
+		Frame[y] = PackRow(CoreInterpreter.Display.data() + y * 64);
+	}
+}
+f64 ObservationPipeline::Score(const Chip8State &CoreInterpreter, const RewardRule &Rule) const {
+	f64 Value = 0;
+	for (u32 i = 0; i < Rule.Length; ++i) {
+		u8 Byte = CoreInterpreter.Memory[(Rule.Address + i) & 0xFFF];
+		Value = Value * (Rule.Encoding == ScoreEncoding::BCD ? 10 : 256) + Byte;
+	}
+	return Value;
+}
+void ObservationPipeline::Push() {
+	PackedFrame &Frame = Stack[StackHead];
+	for (i32 y = 0; y < 32; ++y) {
+		Frame[y] = Config.MaxPool ? Current[y] | Previous[y] : Current[y];
+	}
+	StackHead = (StackHead + 1) % Stack.size();
+}
+void ObservationPipeline::Write(void *Output) const {
+	u8 *Bytes = static_cast<u8 *>(Output);
+	for (size_t i = 0; i < Stack.size(); ++i) {
+		const PackedFrame &Frame = Stack[(StackHead + i) % Stack.size()];
+		u8 *FrameOutput = Bytes + i * FrameSize();
+
+		for (i32 y = 0; y < 32; ++y) {
+			if (Config.Format == ObservationFormat::F32) {
+				UnpackRow(Frame[y], reinterpret_cast<f32 *>(FrameOutput) + y * 64, Config.OnScale);
+			} else {
+				UnpackRow(Frame[y], FrameOutput + y * 64, Config.OnValue);
+			}
+		}
+	}
+}
+void ObservationPipeline::Reset(const Chip8State &CoreInterpreter) {
+	Pack(CoreInterpreter, Current);
+	Previous = Current;
+	std::fill(Stack.begin(), Stack.end(), Current);
+	StackHead = 0;
+
+	for (size_t i = 0; i < Config.Rewards.size(); ++i) {
+		Scores[i] = Score(CoreInterpreter, Config.Rewards[i]);
+	}
+}
+void ObservationPipeline::Capture(const Chip8State &CoreInterpreter) {
+	Previous = Current;
+	Pack(CoreInterpreter, Current);
+}
+void ObservationPipeline::Step(const Chip8State &CoreInterpreter, void *Output, f32 *Reward, u8 *Done) {
+	Capture(CoreInterpreter);
+	Push();
+	Write(Output);
+
+	f64 Total = 0;
+	for (size_t i = 0; i < Config.Rewards.size(); ++i) {
+		f64 Value = Score(CoreInterpreter, Config.Rewards[i]);
+		Total += (Value - Scores[i]) * Config.Rewards[i].Scale;
+		Scores[i] = Value;
+	}
+	if (Reward != nullptr) {
+		*Reward = static_cast<f32>(Total);
+	}
+
+	if (Done != nullptr) {
+		*Done = 0;
+		for (const auto &Rule : Config.Dones) {
+			bool Matches = (CoreInterpreter.Memory[Rule.Address & 0xFFF] & Rule.Mask) == Rule.Value;
+			if (Matches == Rule.Equal) {
+				*Done = 1;
+				break;
+			}
+		}
+	}
+}
+void ObservationPipeline::StepBatch(ObservationPipeline *Pipelines, const Chip8State *const *Instances, size_t Count,
+                                    void *Output, f32 *Rewards, u8 *Dones) {
+	u8 *Bytes = static_cast<u8 *>(Output);
+	for (size_t i = 0; i < Count; ++i) {
+		Pipelines[i].Step(*Instances[i], Bytes, Rewards != nullptr ? Rewards + i : nullptr, Dones != nullptr ? Dones + i : nullptr);
+		Bytes += Pipelines[i].ObservationSize();
+	}
+}
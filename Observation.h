@@ -0,0 +1,86 @@
+#ifndef OBSERVATION_H
+#define OBSERVATION_H
+
+#include <vector>
+
+#include "Type.h"
+#include "Chip8.h"
+
+enum class ObservationFormat : u8 {
+	U8,
+	F32,
+};
+
+enum class ScoreEncoding : u8 {
+	// Big Endian Unsigned Integer of Length Bytes
+	Binary,
+	// One Decimal Digit per Byte, Most Significant First, as FX33 Stores it
+	BCD,
+};
+
+struct RewardRule {
+	u16 Address;
+	u8 Length = 1;
+	ScoreEncoding Encoding = ScoreEncoding::Binary;
+	f32 Scale = 1.0f;
+};
+
+struct DoneRule {
+	u16 Address;
+	u8 Mask = 0xFF;
+	u8 Value = 0;
+	bool Equal = true;
+};
+
+struct ObservationConfig {
+	i32 StackSize = 4;
+	// Max Pool the Last Two Captured Frames to Undo Sprite Flicker
+	bool MaxPool = true;
+	ObservationFormat Format = ObservationFormat::U8;
+	u8 OnValue = 255;
+	f32 OnScale = 1.0f;
+	std::vector<RewardRule> Rewards;
+	std::vector<DoneRule> Dones;
+};
+
+/*
+ * Turns the Display and Memory of a Machine into what a Learning Agent Consumes: a Stack of the Last StackSize
+ * Observations (Oldest First, Each 32 Rows of 64 Pixels), a Reward from Score Bytes and a Done Flag.
+ * Frames are Kept as Packed Rows of 64 Bits, so Pooling is an OR and Stacking Copies 256 Bytes per Frame.
+ * With Frame Skipping, Call Capture After the Second to Last Emulated Frame of a Step so Pooling Sees Both.
+ */
+class ObservationPipeline {
+	private:
+		using PackedFrame = Array<u64, 32>;
+
+		ObservationConfig Config;
+		std::vector<PackedFrame> Stack;
+		size_t StackHead = 0;
+		PackedFrame Previous = {};
+		PackedFrame Current = {};
+		std::vector<f64> Scores;
+
+		static void Pack(const Chip8State &CoreInterpreter, PackedFrame &Frame);
+		f64 Score(const Chip8State &CoreInterpreter, const RewardRule &Rule) const;
+		void Push();
+		void Write(void *Output) const;
+
+	public:
+		explicit ObservationPipeline(const ObservationConfig &Config);
+
+		const ObservationConfig &GetConfig() const {
+			return Config;
+		}
+		size_t FrameSize() const;
+		size_t ObservationSize() const;
+
+		void Reset(const Chip8State &CoreInterpreter);
+		void Capture(const Chip8State &CoreInterpreter);
+		void Step(const Chip8State &CoreInterpreter, void *Output, f32 *Reward, u8 *Done);
+
+		// Output, Rewards and Dones are Contiguous, Each Observation Follows the Previous One, Pipelines May Differ in Size
+		static void StepBatch(ObservationPipeline *Pipelines, const Chip8State *const *Instances, size_t Count, void *Output,
+		                      f32 *Rewards, u8 *Dones);
+};
+
+#endif //OBSERVATION_H
@@ -0,0 +1,62 @@
+#include <chrono>
+
+#include "RomLoader.h"
+
+RomLoader::RomLoader() {
+	Worker = std::thread(&RomLoader::Run, this);
+}
+RomLoader::~RomLoader() {
+	{
+		std::lock_guard Lock(Mutex);
+		Stopping = true;
+	}
+	Wake.notify_one();
+	Worker.join();
+
+	delete Ready.exchange(nullptr);
+}
+void RomLoader::Request(const String &Path) {
+	{
+		std::lock_guard Lock(Mutex);
+		PendingPath = Path;
+		HasPending = true;
+		Busy.store(true, std::memory_order_relaxed);
+	}
+	Wake.notify_one();
+}
+std::unique_ptr<LoadedProgram> RomLoader::TakeReady() {
+	return std::unique_ptr<LoadedProgram>(Ready.exchange(nullptr, std::memory_order_acquire));
+}
+void RomLoader::Run() {
+	while (true) {
+		String Path;
+		{
+			std::unique_lock Lock(Mutex);
+			Wake.wait(Lock, [this] {
+				return HasPending || Stopping;
+			});
+			if (Stopping) {
+				return;
+			}
+			Path = PendingPath;
+			HasPending = false;
+		}
+
+		auto Machine = std::make_unique<Chip8>();
+		Machine->Reset();
+		Machine->Seed(static_cast<u64>(std::chrono::system_clock::now().time_since_epoch().count()));
+		bool Loaded = Machine->LoadProgram(Path);
+
+		if (Loaded) {
+			auto Program = std::make_unique<LoadedProgram>();
+			Program->Path = Path;
+			Program->State = *Machine;
+			Program->State.Redraw = true;
+			delete Ready.exchange(Program.release(), std::memory_order_release);
+		}
+
+		std::lock_guard Lock(Mutex);
+		Failed.store(!Loaded, std::memory_order_relaxed);
+		Busy.store(HasPending, std::memory_order_relaxed);
+	}
+}
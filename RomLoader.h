@@ -0,0 +1,55 @@
+#ifndef ROMLOADER_H
+#define ROMLOADER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "Type.h"
+#include "Chip8.h"
+
+struct LoadedProgram {
+	String Path;
+	Chip8State State;
+};
+
+/*
+ * Loads and Validates ROMs on a Worker Thread and Builds a Fully Initialised Machine for them, so Switching
+ * Programs Never Stalls the Render Thread. The Newest Request Wins, Older Pending Requests are Dropped.
+ */
+class RomLoader {
+	private:
+		std::thread Worker;
+		std::mutex Mutex;
+		std::condition_variable Wake;
+		String PendingPath;
+		bool HasPending = false;
+		bool Stopping = false;
+
+		std::atomic<LoadedProgram *> Ready = nullptr;
+		std::atomic<bool> Busy = false;
+		std::atomic<bool> Failed = false;
+
+		void Run();
+
+	public:
+		RomLoader();
+		~RomLoader();
+		RomLoader(const RomLoader &) = delete;
+		RomLoader &operator=(const RomLoader &) = delete;
+
+		void Request(const String &Path);
+		// Non Blocking, Returns the Most Recently Finished Program Once
+		std::unique_ptr<LoadedProgram> TakeReady();
+
+		bool IsBusy() const {
+			return Busy.load(std::memory_order_relaxed);
+		}
+		bool HasFailed() const {
+			return Failed.load(std::memory_order_relaxed);
+		}
+};
+
+#endif //ROMLOADER_H
@@ -0,0 +1,262 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "SaveState.h"
+
+namespace {
+	constexpr char SAVE_STATE_MAGIC[4] = {'O', '8', 'S', 'S'};
+	constexpr char SAVE_STATE_BANK_MAGIC[4] = {'O', '8', 'S', 'B'};
+	constexpr u32 SAVE_STATE_STRIDE = (sizeof(SaveStateHeader) + sizeof(Chip8State) + SAVE_STATE_ALIGNMENT - 1) / SAVE_STATE_ALIGNMENT * SAVE_STATE_ALIGNMENT;
+
+	static_assert(std::is_trivially_copyable_v<Chip8State> && std::is_standard_layout_v<Chip8State>);
+	static_assert(sizeof(SaveStateHeader) == SAVE_STATE_ALIGNMENT && sizeof(SaveStateBankHeader) == SAVE_STATE_ALIGNMENT);
+	// Implicit Padding would Make the Checksum Depend on Uninitialised Bytes
+	static_assert(sizeof(Chip8State) == 4 * 8 + 4096 + 2048 + 16 * 2 + 16 + 16 + 3 * 2 + 2 + 2 + 6);
+	static_assert(sizeof(Chip8State) % 8 == 0);
+
+	void WriteEntry(std::ostream &Output, const Chip8State &State) {
+		SaveStateHeader Header = {};
+		std::memcpy(Header.Magic, SAVE_STATE_MAGIC, 4);
+		Header.Version = SAVE_STATE_VERSION;
+		Header.HeaderSize = sizeof(SaveStateHeader);
+		Header.StateSize = sizeof(Chip8State);
+		Header.ProgramHash = State.ProgramHash;
+		Header.Checksum = SaveState::Checksum(State);
+
+		char Padding[SAVE_STATE_ALIGNMENT] = {};
+		Output.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+		Output.write(reinterpret_cast<const char *>(&State), sizeof(Chip8State));
+		Output.write(Padding, SAVE_STATE_STRIDE - sizeof(Header) - sizeof(Chip8State));
+	}
+
+	bool RestoreEntry(const u8 *Entry, Chip8 &CoreInterpreter, bool Verify) {
+		const auto *Header = reinterpret_cast<const SaveStateHeader *>(Entry);
+		if (std::memcmp(Header->Magic, SAVE_STATE_MAGIC, 4) != 0 || Header->Version != SAVE_STATE_VERSION ||
+		    Header->HeaderSize != sizeof(SaveStateHeader) || Header->StateSize != sizeof(Chip8State)) {
+			std::cerr << "Incompatible Save State" << std::endl;
+			return false;
+		}
+
+		// A Machine with a Program Loaded Only Takes States of that Program
+		if (CoreInterpreter.ProgramHash != 0 && Header->ProgramHash != CoreInterpreter.ProgramHash) {
+			std::cerr << "Save State is for a Different ROM" << std::endl;
+			return false;
+		}
+
+		const auto *State = reinterpret_cast<const Chip8State *>(Entry + sizeof(SaveStateHeader));
+		if (Verify && SaveState::Checksum(*State) != Header->Checksum) {
+			std::cerr << "Corrupt Save State, Checksum Mismatch" << std::endl;
+			return false;
+		}
+
+		static_cast<Chip8State &>(CoreInterpreter) = *State;
+		CoreInterpreter.Redraw = true;
+		return true;
+	}
+}
+
+MappedFile::~MappedFile() {
+	Close();
+}
+bool MappedFile::Open(const String &File) {
+	Close();
+
+#ifdef _WIN32
+	FileHandle = CreateFileA(File.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (FileHandle == INVALID_HANDLE_VALUE) {
+		FileHandle = nullptr;
+		return false;
+	}
+
+	LARGE_INTEGER FileSize;
+	if (!GetFileSizeEx(FileHandle, &FileSize) || FileSize.QuadPart == 0) {
+		Close();
+		return false;
+	}
+	Size = static_cast<size_t>(FileSize.QuadPart);
+
+	MappingHandle = CreateFileMappingA(FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (MappingHandle == nullptr) {
+		Close();
+		return false;
+	}
+
+	Data = static_cast<const u8 *>(MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+	FileDescriptor = open(File.c_str(), O_RDONLY);
+	if (FileDescriptor < 0) {
+		return false;
+	}
+
+	struct stat FileStatus;
+	if (fstat(FileDescriptor, &FileStatus) != 0 || FileStatus.st_size == 0) {
+		Close();
+		return false;
+	}
+	Size = static_cast<size_t>(FileStatus.st_size);
+
+	void *Mapping = mmap(nullptr, Size, PROT_READ, MAP_SHARED, FileDescriptor, 0);
+	Data = Mapping != MAP_FAILED ? static_cast<const u8 *>(Mapping) : nullptr;
+#endif
+
+	if (Data == nullptr) {
+		Close();
+		return false;
+	}
+	return true;
+}
+void MappedFile::Close() {
+#ifdef _WIN32
+	if (Data != nullptr) {
+		UnmapViewOfFile(Data);
+	}
+	if (MappingHandle != nullptr) {
+		CloseHandle(MappingHandle);
+	}
+	if (FileHandle != nullptr) {
+		CloseHandle(FileHandle);
+	}
+	MappingHandle = nullptr;
+	FileHandle = nullptr;
+#else
+	if (Data != nullptr) {
+		munmap(const_cast<u8 *>(Data), Size);
+	}
+	if (FileDescriptor >= 0) {
+		close(FileDescriptor);
+	}
+	FileDescriptor = -1;
+#endif
+	Data = nullptr;
+	Size = 0;
+}
+
+u64 SaveState::Checksum(const Chip8State &State) {
+	// Word at a Time Multiply-XorShift, Cheap Enough to Verify Every Restore
+	const u8 *Bytes = reinterpret_cast<const u8 *>(&State);
+	u64 Hash = 0xCBF29CE484222325;
+	for (size_t i = 0; i < sizeof(Chip8State); i += 8) {
+		u64 Word;
+		std::memcpy(&Word, Bytes + i, 8);
+		Hash = (Hash ^ Word) * 0x9E3779B97F4A7C15;
+		Hash ^= Hash >> 32;
+	}
+	return Hash;
+}
+bool SaveState::Save(const Chip8 &CoreInterpreter, const String &File) {
+	std::ofstream OutputFile(File, std::ios::binary | std::ios::trunc);
+	if (!OutputFile.is_open()) {
+		std::cerr << "Failed to Open Save State File: " << File << std::endl;
+		return false;
+	}
+
+	WriteEntry(OutputFile, CoreInterpreter);
+	if (!OutputFile.good()) {
+		std::cerr << "Failed to Write Save State File: " << File << std::endl;
+		return false;
+	}
+	return true;
+}
+bool SaveState::Load(Chip8 &CoreInterpreter, const String &File) {
+	MappedFile Mapping;
+	if (!Mapping.Open(File)) {
+		std::cerr << "Failed to Open Save State File: " << File << std::endl;
+		return false;
+	}
+	if (Mapping.GetSize() < SAVE_STATE_STRIDE) {
+		std::cerr << "Truncated Save State File: " << File << std::endl;
+		return false;
+	}
+	return RestoreEntry(Mapping.GetData(), CoreInterpreter, true);
+}
+
+bool SaveStateBank::Append(const Chip8 &CoreInterpreter, const String &File) {
+	SaveStateBankHeader Header = {};
+
+	if (!std::filesystem::exists(File)) {
+		std::memcpy(Header.Magic, SAVE_STATE_BANK_MAGIC, 4);
+		Header.Version = SAVE_STATE_VERSION;
+		Header.HeaderSize = sizeof(SaveStateBankHeader);
+		Header.StateSize = sizeof(Chip8State);
+		Header.Stride = SAVE_STATE_STRIDE;
+		std::ofstream(File, std::ios::binary).write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+	}
+
+	std::fstream BankFile(File, std::ios::binary | std::ios::in | std::ios::out);
+	if (!BankFile.is_open() || !BankFile.read(reinterpret_cast<char *>(&Header), sizeof(Header))) {
+		std::cerr << "Failed to Open Save State Bank: " << File << std::endl;
+		return false;
+	}
+	if (std::memcmp(Header.Magic, SAVE_STATE_BANK_MAGIC, 4) != 0 || Header.Version != SAVE_STATE_VERSION ||
+	    Header.StateSize != sizeof(Chip8State) || Header.Stride != SAVE_STATE_STRIDE) {
+		std::cerr << "Incompatible Save State Bank: " << File << std::endl;
+		return false;
+	}
+
+	BankFile.seekp(static_cast<std::streamoff>(sizeof(Header) + Header.Count * Header.Stride));
+	WriteEntry(BankFile, CoreInterpreter);
+
+	// Count Last, a Failed Append Leaves the Bank Readable
+	Header.Count++;
+	BankFile.seekp(0);
+	BankFile.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+	return BankFile.good();
+}
+bool SaveStateBank::Open(const String &File) {
+	Close();
+
+	if (!Mapping.Open(File)) {
+		std::cerr << "Failed to Open Save State Bank: " << File << std::endl;
+		return false;
+	}
+
+	const auto *BankHeader = reinterpret_cast<const SaveStateBankHeader *>(Mapping.GetData());
+	if (Mapping.GetSize() < sizeof(SaveStateBankHeader) || std::memcmp(BankHeader->Magic, SAVE_STATE_BANK_MAGIC, 4) != 0 ||
+	    BankHeader->Version != SAVE_STATE_VERSION || BankHeader->StateSize != sizeof(Chip8State) ||
+	    BankHeader->Stride != SAVE_STATE_STRIDE) {
+		std::cerr << "Incompatible Save State Bank: " << File << std::endl;
+		Mapping.Close();
+		return false;
+	}
+	// Divide Rather than Multiply, a Corrupt Count could Overflow the Product Past the Size Check
+	if (BankHeader->Count > (Mapping.GetSize() - sizeof(SaveStateBankHeader)) / BankHeader->Stride) {
+		std::cerr << "Truncated Save State Bank: " << File << std::endl;
+		Mapping.Close();
+		return false;
+	}
+
+	Header = BankHeader;
+	return true;
+}
+void SaveStateBank::Close() {
+	Header = nullptr;
+	Mapping.Close();
+}
+u64 SaveStateBank::ProgramHash(u64 Index) const {
+	if (Index >= Count()) {
+		return 0;
+	}
+	const u8 *Entry = Mapping.GetData() + sizeof(SaveStateBankHeader) + Index * Header->Stride;
+	return reinterpret_cast<const SaveStateHeader *>(Entry)->ProgramHash;
+}
+bool SaveStateBank::Restore(u64 Index, Chip8 &CoreInterpreter, bool Verify) const {
+	if (Index >= Count()) {
+		std::cerr << "Save State Index Out of Range: " << Index << std::endl;
+		return false;
+	}
+	return RestoreEntry(Mapping.GetData() + sizeof(SaveStateBankHeader) + Index * Header->Stride, CoreInterpreter, Verify);
+}
@@ -0,0 +1,91 @@
+#ifndef SAVESTATE_H
+#define SAVESTATE_H
+
+#include "Type.h"
+#include "Chip8.h"
+
+#define SAVE_STATE_VERSION 1
+#define SAVE_STATE_ALIGNMENT 64
+
+/*
+ * Save State Entry: a 64 Byte Header Followed Directly by the Raw Chip8State, Padded to a Multiple of 64 Bytes.
+ * A Single State File is One Entry, a Bank File is a 64 Byte Bank Header Followed by Count Entries of Stride Bytes,
+ * so the State at Index N Sits at a Fixed Offset and Restoring it from the Mapped File is One Copy.
+ * The State is Stored Exactly as it Lies in Memory, so a File Only Loads Where Chip8State has the Same Layout.
+ */
+struct SaveStateHeader {
+	char Magic[4];
+	u16 Version;
+	u16 HeaderSize;
+	u32 StateSize;
+	u32 Reserved;
+	u64 ProgramHash;
+	u64 Checksum;
+	u8 Padding[32];
+};
+
+struct SaveStateBankHeader {
+	char Magic[4];
+	u16 Version;
+	u16 HeaderSize;
+	u32 StateSize;
+	u32 Stride;
+	u64 Count;
+	u8 Padding[40];
+};
+
+class MappedFile {
+	private:
+		const u8 *Data = nullptr;
+		size_t Size = 0;
+#ifdef _WIN32
+		void *FileHandle = nullptr;
+		void *MappingHandle = nullptr;
+#else
+		i32 FileDescriptor = -1;
+#endif
+
+	public:
+		MappedFile() = default;
+		~MappedFile();
+		MappedFile(const MappedFile &) = delete;
+		MappedFile &operator=(const MappedFile &) = delete;
+
+		bool Open(const String &File);
+		void Close();
+		const u8 *GetData() const {
+			return Data;
+		}
+		size_t GetSize() const {
+			return Size;
+		}
+};
+
+class SaveState {
+	public:
+		static u64 Checksum(const Chip8State &State);
+
+		static bool Save(const Chip8 &CoreInterpreter, const String &File);
+		static bool Load(Chip8 &CoreInterpreter, const String &File);
+};
+
+class SaveStateBank {
+	private:
+		MappedFile Mapping;
+		const SaveStateBankHeader *Header = nullptr;
+
+	public:
+		// Appends the Machine to the Bank, Creating the File if Needed
+		// Restoring Checks the Program Hash Against the Machine's, Unless No Program is Loaded
+		static bool Append(const Chip8 &CoreInterpreter, const String &File);
+
+		bool Open(const String &File);
+		void Close();
+		u64 Count() const {
+			return Header != nullptr ? Header->Count : 0;
+		}
+		u64 ProgramHash(u64 Index) const;
+		bool Restore(u64 Index, Chip8 &CoreInterpreter, bool Verify = true) const;
+};
+
+#endif //SAVESTATE_H
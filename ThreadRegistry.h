@@ -0,0 +1,50 @@
+#ifndef THREADREGISTRY_H
+#define THREADREGISTRY_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Type.h"
+
+// Monotonic Nanoseconds, Shared by Tracing, Metrics and Latency so their Timestamps Line Up
+class Clock {
+	public:
+		static u64 Now() {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+};
+
+/*
+ * One T per Thread, Created on the Thread's First Use. Entries Outlive their Threads, so what Finished Threads
+ * Recorded can Still be Read. Only Registering and Visiting Take the Lock, the Owning Thread Uses its Entry Directly.
+ */
+template <typename T>
+class ThreadRegistry {
+	private:
+		inline static std::mutex Mutex;
+		inline static std::vector<std::unique_ptr<T>> Entries;
+
+		static T *Register() {
+			std::lock_guard Lock(Mutex);
+			Entries.push_back(std::make_unique<T>());
+			return Entries.back().get();
+		}
+
+	public:
+		static T &Local() {
+			thread_local T *Entry = Register();
+			return *Entry;
+		}
+
+		template <typename Visitor>
+		static void ForEach(Visitor &&Visit) {
+			std::lock_guard Lock(Mutex);
+			for (const auto &Entry : Entries) {
+				Visit(*Entry);
+			}
+		}
+};
+
+#endif //THREADREGISTRY_H
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+#include "Trace.h"
+#include "ThreadRegistry.h"
+
+namespace {
+	constexpr u64 TRACE_BUFFER_SIZE = 1 << 16;
+
+	std::atomic<u32> NextThreadID = 1;
+	std::atomic<u64> Generation = 0;
+
+	/*
+	 * Only the Owning Thread Writes Events. Count is Published with Release Ordering After the Event is Written,
+	 * so a Dump Sees Complete Events as Long as the Writer has Not Wrapped Around onto them in the Meantime.
+	 */
+	struct TraceBuffer {
+		std::unique_ptr<TraceEvent[]> Events = std::make_unique<TraceEvent[]>(TRACE_BUFFER_SIZE);
+		std::atomic<u64> Count = 0;
+		std::atomic<u64> First = 0;
+		// A Buffer Registered After a Clear Catches Up the First Time it Records
+		std::atomic<u64> Generation = 0;
+		u32 ThreadID = NextThreadID.fetch_add(1, std::memory_order_relaxed);
+		u32 Depth = 0;
+	};
+
+	TraceBuffer &ThreadBuffer() {
+		return ThreadRegistry<TraceBuffer>::Local();
+	}
+
+	void CopyEvents(const TraceBuffer &Buffer, std::vector<TraceEvent> &Events, u64 Limit) {
+		u64 Count = Buffer.Count.load(std::memory_order_acquire);
+		u64 First = std::max(Buffer.First.load(std::memory_order_relaxed), Count - std::min({Count, Limit, TRACE_BUFFER_SIZE}));
+
+		size_t Offset = Events.size();
+		for (u64 i = First; i < Count; ++i) {
+			Events.push_back(Buffer.Events[i % TRACE_BUFFER_SIZE]);
+		}
+
+		// Drop Anything the Writer may have Overwritten while we were Copying
+		u64 After = Buffer.Count.load(std::memory_order_acquire);
+		if (After > TRACE_BUFFER_SIZE && After - TRACE_BUFFER_SIZE > First) {
+			u64 Lost = std::min(After - TRACE_BUFFER_SIZE - First, Count - First);
+			Events.erase(Events.begin() + Offset, Events.begin() + Offset + Lost);
+		}
+	}
+}
+
+void Tracer::SetEnabled(bool Enable) {
+	Enabled.store(Enable, std::memory_order_relaxed);
+}
+u64 Tracer::BeginZone() {
+	ThreadBuffer().Depth++;
+	return Clock::Now();
+}
+void Tracer::EndZone(const char *Name, u64 Start) {
+	u64 End = Clock::Now();
+	TraceBuffer &Buffer = ThreadBuffer();
+	Buffer.Depth--;
+
+	u64 Count = Buffer.Count.load(std::memory_order_relaxed);
+	u64 CurrentGeneration = Generation.load(std::memory_order_relaxed);
+	if (Buffer.Generation.load(std::memory_order_relaxed) != CurrentGeneration) {
+		Buffer.Generation.store(CurrentGeneration, std::memory_order_relaxed);
+		Buffer.First.store(Count, std::memory_order_relaxed);
+	}
+
+	Buffer.Events[Count % TRACE_BUFFER_SIZE] = {Name, Start, End, Buffer.Depth, Buffer.ThreadID};
+	Buffer.Count.store(Count + 1, std::memory_order_release);
+}
+void Tracer::CancelZone() {
+	ThreadBuffer().Depth--;
+}
+void Tracer::Clear() {
+	// Each Thread Discards its Own Events the Next Time it Records
+	Generation.fetch_add(1, std::memory_order_relaxed);
+
+	TraceBuffer &Buffer = ThreadBuffer();
+	Buffer.Generation.store(Generation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	Buffer.First.store(Buffer.Count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+void Tracer::CopyThreadEvents(std::vector<TraceEvent> &Events, u64 Limit) {
+	TraceBuffer &Buffer = ThreadBuffer();
+	if (Buffer.Generation.load(std::memory_order_relaxed) != Generation.load(std::memory_order_relaxed)) {
+		return;
+	}
+	CopyEvents(Buffer, Events, Limit);
+}
+bool Tracer::DumpChromeJSON(const String &File) {
+	std::vector<TraceEvent> Events;
+	u64 CurrentGeneration = Generation.load(std::memory_order_relaxed);
+	ThreadRegistry<TraceBuffer>::ForEach([&](const TraceBuffer &Buffer) {
+		// Threads that have Not Recorded Since the Last Clear Only Hold Stale Events
+		if (Buffer.Generation.load(std::memory_order_relaxed) == CurrentGeneration) {
+			CopyEvents(Buffer, Events, TRACE_BUFFER_SIZE);
+		}
+	});
+
+	std::ofstream OutputFile(File);
+	if (!OutputFile.is_open()) {
+		std::cerr << "Failed to Open Trace File: " << File << std::endl;
+		return false;
+	}
+
+	u64 Origin = UINT64_MAX;
+	for (const auto &Event : Events) {
+		Origin = std::min(Origin, Event.Start);
+	}
+
+	// Chrome Trace Event Format, Complete ("X") Events with Microsecond Timestamps
+	OutputFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	OutputFile << std::fixed;
+	OutputFile.precision(3);
+	for (size_t i = 0; i < Events.size(); ++i) {
+		const auto &Event = Events[i];
+		OutputFile << (i == 0 ? "\n" : ",\n");
+		OutputFile << "{\"name\":\"" << Event.Name << "\",\"cat\":\"OctoPlay\",\"ph\":\"X\",\"pid\":1,\"tid\":" << Event.ThreadID
+				   << ",\"ts\":" << (Event.Start - Origin) / 1000.0 << ",\"dur\":" << (Event.End - Event.Start) / 1000.0 << "}";
+	}
+	OutputFile << "\n]}" << std::endl;
+
+	std::cout << "Trace Written: " << File << " (" << Events.size() << " events)" << std::endl;
+	return OutputFile.good();
+}
@@ -0,0 +1,74 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <vector>
+
+#include "Type.h"
+
+/*
+ * Scoped Zone Frame Tracer. Every Thread Records into its Own Fixed Size Buffer, so Recording Never Takes a Lock.
+ * Zone Names Must be String Literals, Only the Pointer is Stored.
+ */
+struct TraceEvent {
+	const char *Name;
+	u64 Start;
+	u64 End;
+	u32 Depth;
+	u32 ThreadID;
+};
+
+class Tracer {
+	private:
+		inline static std::atomic<bool> Enabled = false;
+
+	public:
+		static bool IsEnabled() {
+			return Enabled.load(std::memory_order_relaxed);
+		}
+		static void SetEnabled(bool Enable);
+
+		static u64 BeginZone();
+		static void EndZone(const char *Name, u64 Start);
+		static void CancelZone();
+
+		static void Clear();
+		static void CopyThreadEvents(std::vector<TraceEvent> &Events, u64 Limit);
+		static bool DumpChromeJSON(const String &File);
+};
+
+class TraceZone {
+	private:
+		const char *Name;
+		u64 Start = 0;
+		bool Active;
+
+	public:
+		explicit TraceZone(const char *Name) : Name(Name), Active(Tracer::IsEnabled()) {
+			if (Active) {
+				Start = Tracer::BeginZone();
+			}
+		}
+		~TraceZone() {
+			if (Active) {
+				Tracer::EndZone(Name, Start);
+			}
+		}
+
+		// Drops the Zone, Zones Already Recorded Inside it are Kept
+		void Cancel() {
+			if (Active) {
+				Active = false;
+				Tracer::CancelZone();
+			}
+		}
+
+		TraceZone(const TraceZone &) = delete;
+		TraceZone &operator=(const TraceZone &) = delete;
+};
+
+#define TRACE_CONCAT_INNER(A, B) A##B
+#define TRACE_CONCAT(A, B) TRACE_CONCAT_INNER(A, B)
+#define TRACE_ZONE(Name) TraceZone TRACE_CONCAT(TraceZone, __LINE__)(Name)
+
+#endif //TRACE_H
@@ -0,0 +1,140 @@
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+
+#include "ExecutionTrace.h"
+#include "Type.h"
+
+// Traces From Different Interpreters Count Cycles Differently (e.g. while Waiting on FX0A), so Cycles are Not Compared
+static bool SameState(const ExecutionRecord &A, const ExecutionRecord &B) {
+	return A.ProgramCounter == B.ProgramCounter && A.OperationCode == B.OperationCode &&
+	       A.IndexRegister == B.IndexRegister && A.Register == B.Register;
+}
+
+static void PrintRecord(const char *Label, u64 Index, const ExecutionRecord &Record) {
+	std::cout << Label << " #" << std::dec << Index << " Cycle " << Record.Cycle << std::hex << std::setfill('0')
+	          << "  PC " << std::setw(3) << Record.ProgramCounter << "  " << std::setw(4) << Record.OperationCode
+	          << "  I " << std::setw(3) << Record.IndexRegister << " ";
+	for (i32 i = 0; i < 16; ++i) {
+		std::cout << " " << std::setw(2) << static_cast<i32>(Record.Register[i]);
+	}
+	std::cout << std::dec << std::setfill(' ') << std::endl;
+}
+
+static void PrintDifference(const ExecutionRecord &A, const ExecutionRecord &B) {
+	std::cout << "Differs In:" << std::hex;
+	if (A.ProgramCounter != B.ProgramCounter) {
+		std::cout << " PC (" << A.ProgramCounter << " vs " << B.ProgramCounter << ")";
+	}
+	if (A.OperationCode != B.OperationCode) {
+		std::cout << " Opcode (" << A.OperationCode << " vs " << B.OperationCode << ")";
+	}
+	if (A.IndexRegister != B.IndexRegister) {
+		std::cout << " I (" << A.IndexRegister << " vs " << B.IndexRegister << ")";
+	}
+	for (i32 i = 0; i < 16; ++i) {
+		if (A.Register[i] != B.Register[i]) {
+			std::cout << " v" << i << " (" << static_cast<i32>(A.Register[i]) << " vs " << static_cast<i32>(B.Register[i]) << ")";
+		}
+	}
+	std::cout << std::dec << std::endl;
+}
+
+/*
+ * Skips Records of the Trace that Started Earlier until its State Matches the First Record of the Other,
+ * so Traces Started at Different Points of the Same Run Line Up.
+ */
+static bool Align(ExecutionTraceReader &Reader, ExecutionRecord &Record, u64 &Index, const ExecutionRecord &Target, u64 Window) {
+	for (u64 i = 0; i < Window; ++i) {
+		if (SameState(Record, Target)) {
+			return true;
+		}
+		if (!Reader.Next(Record)) {
+			return false;
+		}
+		Index++;
+	}
+	return SameState(Record, Target);
+}
+
+i32 main(i32 args, char **argv) {
+	if (args < 3) {
+		std::cerr << "Usage: " << std::endl << argv[0] << " TraceA.o8x TraceB.o8x [Context Records] [Align Window]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	u64 Context = args > 3 ? std::strtoull(argv[3], nullptr, 10) : 8;
+	u64 Window = args > 4 ? std::strtoull(argv[4], nullptr, 10) : 1000000;
+
+	ExecutionTraceReader ReaderA, ReaderB;
+	if (!ReaderA.Open(argv[1]) || !ReaderB.Open(argv[2])) {
+		return EXIT_FAILURE;
+	}
+
+	ExecutionRecord A, B;
+	u64 IndexA = 0, IndexB = 0;
+	bool HasA = ReaderA.Next(A);
+	bool HasB = ReaderB.Next(B);
+	if (!HasA || !HasB) {
+		std::cout << "Empty Trace: " << (HasA ? argv[2] : argv[1]) << std::endl;
+		return HasA == HasB ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	ExecutionRecord FirstA = A, FirstB = B;
+	if (!SameState(A, B)) {
+		bool Aligned = Align(ReaderB, B, IndexB, FirstA, Window);
+		if (!Aligned) {
+			ReaderB.Open(argv[2]);
+			ReaderB.Next(B);
+			IndexB = 0;
+			Aligned = Align(ReaderA, A, IndexA, FirstB, Window);
+		}
+		if (!Aligned) {
+			std::cout << "Unable to Align Traces Within " << Window << " Records" << std::endl;
+			PrintRecord("A", 0, FirstA);
+			PrintRecord("B", 0, FirstB);
+			return EXIT_FAILURE;
+		}
+		std::cout << "Aligned A #" << IndexA << " with B #" << IndexB << std::endl;
+	}
+
+	std::deque<ExecutionRecord> History;
+	u64 Matched = 0;
+	while (true) {
+		if (!SameState(A, B)) {
+			std::cout << "First Divergence After " << Matched << " Matching Records" << std::endl;
+			for (u64 i = 0; i < History.size(); ++i) {
+				PrintRecord(" ", IndexA - History.size() + i, History[i]);
+			}
+			PrintRecord("A", IndexA, A);
+			PrintRecord("B", IndexB, B);
+			PrintDifference(A, B);
+			return EXIT_FAILURE;
+		}
+
+		Matched++;
+		History.push_back(A);
+		if (History.size() > Context) {
+			History.pop_front();
+		}
+
+		HasA = ReaderA.Next(A);
+		HasB = ReaderB.Next(B);
+		IndexA++;
+		IndexB++;
+
+		if (!HasA || !HasB) {
+			break;
+		}
+	}
+
+	if (HasA != HasB) {
+		std::cout << "Traces Match for " << Matched << " Records, then " << (HasA ? "B" : "A") << " Ends" << std::endl;
+		PrintRecord(HasA ? "A" : "B", HasA ? IndexA : IndexB, HasA ? A : B);
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "Traces Match: " << Matched << " Records" << std::endl;
+	return EXIT_SUCCESS;
+}
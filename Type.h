@@ -14,14 +14,15 @@ using InputFileStream = std::ifstream;
 using NanoTimePoint = std::chrono::system_clock::time_point;
 using HighResolutionClock = std::chrono::high_resolution_clock;
 
+// Binary Files (Movies, Save States, Execution Traces) Store these in Host Byte Order, Little Endian on Every Platform we Build For
 using i8 = int8_t;
 using i16 = int16_t;
 using i32 = int32_t;
 using i64 = int64_t;
 using u8 = uint8_t;
 using u16 = uint16_t;
-using u32 = int32_t;
-using u64 = int64_t;
+using u32 = uint32_t;
+using u64 = uint64_t;
 using f32 = float;
 using f64 = double;
 
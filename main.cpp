@@ -1,5 +1,6 @@
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 
 #include <glad/glad.h>
@@ -12,18 +13,50 @@
 #include "Chip8.h"
 #include "Type.h"
 #include "GUI.h"
+#include "Trace.h"
+#include "Metrics.h"
 
 static void GLFWErrorCallback(int Error, const char *Description) {
 	std::cerr << "GLFW Error " << Error << ": " << Description << std::endl;
 }
 
+static void GLFWDropCallback(GLFWwindow *Window, int Count, const char **Paths) {
+	auto *gui = static_cast<GUI *>(glfwGetWindowUserPointer(Window));
+	if (gui != nullptr && Count > 0) {
+		gui->RequestProgram(Paths[0]);
+	}
+}
+
+static void GLFWKeyCallback(GLFWwindow *Window, int Key, int, int Action, int) {
+	auto *gui = static_cast<GUI *>(glfwGetWindowUserPointer(Window));
+	if (gui != nullptr) {
+		gui->OnKey(Key, Action);
+	}
+}
+
+// Any Window Event Means the UI May Change, so the Adaptive Loop Renders Again
+static void NotifyInput(GLFWwindow *Window) {
+	auto *gui = static_cast<GUI *>(glfwGetWindowUserPointer(Window));
+	if (gui != nullptr) {
+		gui->NotifyInput();
+	}
+}
+
 i32 main(i32 args, char **argv) {
-	if (args < 2) {
-		std::cerr << "Usage: " << std::endl << argv[0] << " Chip 8 Program Path the ROM is in .ch8/.CH8" << std::endl;
-		return EXIT_FAILURE;
+	// The ROM is Optional, Programs can be Dropped on the Window or Picked in the ROM Browser
+	const char *ProgramPath = "";
+	const char *MetricsPath = nullptr;
+	for (i32 i = 1; i < args; ++i) {
+		if (std::strcmp(argv[i], "--metrics-file") == 0 && i + 1 < args) {
+			MetricsPath = argv[++i];
+		} else {
+			ProgramPath = argv[i];
+		}
 	}
 
-	srand(static_cast<unsigned>(time(nullptr)));
+	if (MetricsPath != nullptr && !Metrics::StartExport(MetricsPath)) {
+		return EXIT_FAILURE;
+	}
 
 	glfwSetErrorCallback(GLFWErrorCallback);
 	if (!glfwInit()) {
@@ -63,6 +96,16 @@ i32 main(i32 args, char **argv) {
 	Style.WindowPadding = ImVec2(16, 12);
 	Style.Colors[ImGuiCol_WindowBg] = ImVec4(0.078f, 0.078f, 0.082f, 1.0f);
 
+	// Installed Before the ImGui Backend, which Chains to Callbacks that are Already Set
+	glfwSetKeyCallback(Window, GLFWKeyCallback);
+	glfwSetCharCallback(Window, [](GLFWwindow *Window, unsigned int) { NotifyInput(Window); });
+	glfwSetMouseButtonCallback(Window, [](GLFWwindow *Window, int, int, int) { NotifyInput(Window); });
+	glfwSetCursorPosCallback(Window, [](GLFWwindow *Window, double, double) { NotifyInput(Window); });
+	glfwSetScrollCallback(Window, [](GLFWwindow *Window, double, double) { NotifyInput(Window); });
+	glfwSetWindowFocusCallback(Window, [](GLFWwindow *Window, int) { NotifyInput(Window); });
+	glfwSetCursorEnterCallback(Window, [](GLFWwindow *Window, int) { NotifyInput(Window); });
+	glfwSetFramebufferSizeCallback(Window, [](GLFWwindow *Window, int, int) { NotifyInput(Window); });
+	glfwSetWindowRefreshCallback(Window, [](GLFWwindow *Window) { NotifyInput(Window); });
 	ImGui_ImplGlfw_InitForOpenGL(Window, true);
 	ImGui_ImplOpenGL3_Init(GLSLVersion);
 
@@ -89,41 +132,71 @@ i32 main(i32 args, char **argv) {
 
 	Chip8 CoreInterpreter;
 	CoreInterpreter.Reset();
+	CoreInterpreter.Seed(static_cast<u64>(time(nullptr)));
 
-	if (!CoreInterpreter.LoadProgram(argv[1])) {
-		std::cerr << "Unable to Load" << argv[1] << std::endl;
+	if (*ProgramPath != '\0' && !CoreInterpreter.LoadProgram(ProgramPath)) {
+		std::cerr << "Unable to Load" << ProgramPath << std::endl;
 		return -1;
 	}
 
-	GUI gui(&CoreInterpreter, DisplayTexture, DisplayPixels);
+	GUI gui(&CoreInterpreter, ProgramPath, DisplayTexture, DisplayPixels);
+	glfwSetWindowUserPointer(Window, &gui);
+	glfwSetDropCallback(Window, GLFWDropCallback);
 
 	while (!glfwWindowShouldClose(Window)) {
-		glfwPollEvents();
+		{
+			TRACE_ZONE("Wait Events");
+			f64 Timeout = gui.WaitTimeout();
+			if (Timeout > 0) {
+				glfwWaitEventsTimeout(Timeout);
+			} else {
+				glfwPollEvents();
+			}
+		}
 
-		ImGui_ImplOpenGL3_NewFrame();
-		ImGui_ImplGlfw_NewFrame();
-		ImGui::NewFrame();
+		// Only Iterations that Present are Frames, Idle Wake-Ups would Crowd them Out of the Trace
+		TraceZone FrameZone(TRACE_FRAME_ZONE);
+		gui.Update();
+		if (!gui.NeedsFrame()) {
+			FrameZone.Cancel();
+			continue;
+		}
 
-		gui.Render();
+		{
+			TRACE_ZONE("UI Build");
+			ImGui_ImplOpenGL3_NewFrame();
+			ImGui_ImplGlfw_NewFrame();
+			ImGui::NewFrame();
 
-		ImGui::Render();
-		i32 DisplayWidth, DisplayHeight;
-		glfwGetFramebufferSize(Window, &DisplayWidth, &DisplayHeight);
-		glViewport(0, 0, DisplayWidth, DisplayHeight);
-		glClearColor(ClearColor.x * ClearColor.w, ClearColor.y * ClearColor.w, ClearColor.z * ClearColor.w, ClearColor.w);
-		glClear(GL_COLOR_BUFFER_BIT);
+			gui.Render();
 
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+			ImGui::Render();
+		}
 
-		// Update and Render Additional Platforms Windows
-		if (IO.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
-			GLFWwindow *BackupCurrentContext = glfwGetCurrentContext();
-			ImGui::UpdatePlatformWindows();
-			ImGui::RenderPlatformWindowsDefault();
-			glfwMakeContextCurrent(BackupCurrentContext);
+		{
+			TRACE_ZONE("Render");
+			i32 DisplayWidth, DisplayHeight;
+			glfwGetFramebufferSize(Window, &DisplayWidth, &DisplayHeight);
+			glViewport(0, 0, DisplayWidth, DisplayHeight);
+			glClearColor(ClearColor.x * ClearColor.w, ClearColor.y * ClearColor.w, ClearColor.z * ClearColor.w, ClearColor.w);
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+			// Update and Render Additional Platforms Windows
+			if (IO.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
+				GLFWwindow *BackupCurrentContext = glfwGetCurrentContext();
+				ImGui::UpdatePlatformWindows();
+				ImGui::RenderPlatformWindowsDefault();
+				glfwMakeContextCurrent(BackupCurrentContext);
+			}
 		}
 
-		glfwSwapBuffers(Window);
+		{
+			TRACE_ZONE("Swap");
+			glfwSwapBuffers(Window);
+			gui.OnPresented();
+		}
 	}
 
 	ImGui_ImplOpenGL3_Shutdown();
@@ -131,6 +204,7 @@ i32 main(i32 args, char **argv) {
 	ImGui::DestroyContext();
 
 	glDeleteTextures(1, &DisplayTexture);
+	Metrics::StopExport();
 
 	glfwDestroyWindow(Window);
 	glfwTerminate();